@@ -10,6 +10,12 @@
 #define SCREEN_WIDTH  800
 #define SCREEN_HEIGHT 480
 
+// Display render modes (selected per board below, override with -DDISPLAY_RENDER_MODE=...)
+// PARTIAL: LVGL renders dirty areas into draw buffers which are copied into the panel framebuffer
+// DIRECT:  LVGL renders straight into the framebuffer scanned out by Panel_RGB (no copy, no draw buffers)
+#define DISPLAY_RENDER_PARTIAL 0
+#define DISPLAY_RENDER_DIRECT  1
+
 // Hardware-specific pin configurations
 #ifdef HARDWARE_ADVANCE
 // CrowPanel 7" Advance - per Elecrow example code
@@ -18,12 +24,18 @@
 #define TOUCH_SCL  16
 #define TOUCH_RST  -1  // Reset handled by STC8H1K28 microcontroller via I2C
 #define TOUCH_INT  -1  // Not used
+#ifndef DISPLAY_RENDER_MODE
+#define DISPLAY_RENDER_MODE DISPLAY_RENDER_DIRECT   // 14MHz PCLK, fast enough scanout to hide direct drawing
+#endif
 #else
 // CrowPanel 7" Basic
 #define TOUCH_SDA  19
 #define TOUCH_SCL  20
 #define TOUCH_RST  38
 #define TOUCH_INT  -1
+#ifndef DISPLAY_RENDER_MODE
+#define DISPLAY_RENDER_MODE DISPLAY_RENDER_PARTIAL  // 10MHz PCLK, slow scanout shows intermediate draws
+#endif
 #endif
 
 // Touch controller I2C address
@@ -35,8 +47,127 @@
 #define GT911_CONFIG_REG  0x8047
 #define GT911_PRODUCT_ID  0x8140
 
-// Display buffer configuration
+// Touch polling: full point reads only run when the GT911 reports a new buffer
+#define TOUCH_ACTIVE_POLL_MS 15        // Input read period while in use
+#define TOUCH_IDLE_POLL_MS 50          // Status-only checks once idle, bounds first-touch latency
+#define TOUCH_INT_IDLE_POLL_MS 1000    // Idle read period with TOUCH_INT wired, the interrupt wakes reads
+#define TOUCH_IDLE_AFTER_MS 1000       // Time since the last touch before polling slows down
+
+// Multi-touch and gestures (GestureRecognizer)
+#define TOUCH_MAX_POINTS 5             // GT911 reports up to 5 points, read in one burst
+#define GESTURE_LONG_PRESS_MS 600
+#define GESTURE_SLOP_PX 12             // Movement that still counts as holding still
+#define GESTURE_SWIPE_MIN_PX 80        // Travel that makes a swipe
+#define GESTURE_EDGE_PX 24             // Start band for edge swipes
+#define GESTURE_PINCH_MIN_PX 24        // Change of finger distance that starts a pinch
+
+// Pointer filtering and prediction (TouchFilter), tune with the 'filter' console command
+// and tools/touch_replay.sh against recorded traces
+#define TOUCH_FILTER_ENABLED 1
+#define TOUCH_FILTER_MIN_CUTOFF_MHZ 1500  // One-euro min cutoff, 1.5 Hz
+#define TOUCH_FILTER_BETA_X1000 15        // One-euro beta 0.015 (Hz per px/s)
+#define TOUCH_FILTER_DCUTOFF_MHZ 3000     // Velocity estimate cutoff, 3 Hz
+#define TOUCH_PREDICT_MS 16               // Extrapolation, about one frame of render + flush
+#define TOUCH_PREDICT_MAX_PX 40
+
+// Display buffer configuration (DISPLAY_RENDER_PARTIAL only)
+// PSRAM: two BUFFER_LINES buffers in PSRAM
+// SRAM:  two stripe buffers in internal DMA-capable SRAM, rendering never touches PSRAM until the copy
+#define DISPLAY_BUFFER_PSRAM 0
+#define DISPLAY_BUFFER_SRAM  1
+#define DISPLAY_BUFFER_STRATEGY DISPLAY_BUFFER_SRAM
 #define BUFFER_LINES 480  // Full screen buffer for smooth rendering (with 8MB PSRAM available)
+#define STRIPE_LINES 0       // SRAM stripe height, 0 = size automatically from free internal heap at boot
+#define STRIPE_LINES_MIN 16  // Auto sizing uses PSRAM buffers rather than go below this
+#define STRIPE_LINES_MAX 120
+#define WIFI_HEAP_RESERVE (96 * 1024)  // Internal heap left free for the Wi-Fi/TCP stack when auto sizing
+#define NATIVE_STRIPE_LINES 64         // Stripe height of the host build (no heap to size against)
+#define DISPLAY_FLUSH_TASK_CORE 0  // Framebuffer copy runs on the core not drawing the UI
+#define DISPLAY_FLUSH_TASK_PRIO 5
+
+// Frame stats (render/flush histograms, dumped with the 'stats' console command)
+#define FRAME_STATS_INTERVAL_MS 0  // Periodic dump over Serial (0 = on demand only)
+#define FRAME_STATS_OVERLAY 0      // Show p50/p95 frame times on screen at boot
+#define TOUCH_LATENCY_TIMEOUT_MS 500  // A press with no response on screen within this is counted as none
+
+// Serial console
+#define CONSOLE_MAX_COMMANDS 16
+#define CONSOLE_LINE_LENGTH 64
+#define CONSOLE_TASK_CORE 0
+
+// Backlight fades (PowerManager dim and off transitions, waking is always instant)
+#define BACKLIGHT_DIM_FADE_MS 1000
+#define BACKLIGHT_OFF_FADE_MS 1500
+#define BACKLIGHT_FADE_STEP_MS 20      // BACKLIGHT_I2C: ramp step, one STC8H1K28 write each
+
+// Rendering per power state (PowerManager): full rate when bright, capped when dimmed,
+// stopped in SCREEN_OFF and redrawn as one frame before the backlight comes back
+#define DIMMED_REFR_PERIOD_MS 100      // 10 fps while dimmed
+
+// I2C bus task (touch poll and coalesced STC8H1K28 writes, 'i2c' console command)
+#define I2C_TASK_CORE 0                // Off the UI core, the UI task never waits on the bus
+#define I2C_TASK_PRIO 4                // Above the UI task, touch polls run on time
+#define I2C_BUS_MAX_DEVICES 4          // Devices with their own transaction statistics
+#define STC8_ADDR 0x30                 // Advance: backlight and buzzer controller
+#define STC8_I2C_FREQ 100000
+
+// Dynamic frequency scaling and automatic light sleep (DynamicPower, 'pm' console command)
+// Needs CONFIG_PM_ENABLE, light sleep also CONFIG_FREERTOS_USE_TICKLESS_IDLE in the framework's sdkconfig
+#define PM_ENABLED 1
+#define PM_MIN_CPU_FREQ_MHZ 80         // Idle frequency, keeps APB at 80 MHz for the RGB panel clocks
+#define PM_LIGHT_SLEEP 1               // Only in SCREEN_OFF, the RGB scanout stops in light sleep
+
+// UI task (LVGL timer handler and power manager)
+#define UI_TASK_CORE 1
+#define UI_TASK_PRIO 3
+#define UI_TASK_STACK_SIZE 16384
+#define UI_TASK_MAX_SLEEP_MS 1000  // Upper bound on a single sleep, deadlines normally wake it earlier
+
+// Image cache (byte budget is LV_CACHE_DEF_SIZE in lv_conf.h, 'cache budget <KB>' changes it at runtime)
+#define IMAGE_CACHE_MAX_PINS 16         // Images kept decoded while they are on the active screen
+#define IMAGE_CACHE_PIN_CHECK_MS 500    // How often the pins are re-synced with the active screen
+
+// Asset partition (images pre-converted by tools/build_assets.py, see data/README.txt)
+#define ASSET_PARTITION_LABEL "assets"
+#define ASSET_PARTITION_SUBTYPE 0x40
+#define ASSET_WALLPAPER "wallpaper"     // Replaces the built-in background when present
+
+// Retained bitmaps (static subtrees rendered once into PSRAM and blitted, 'retained' console command)
+#define RETAINED_BITMAP_MAX 4
+#define RETAINED_HOMEBAR 1              // Pre-compose the translucent home bar over the wallpaper
+
+// Screenshot HTTP server (GET /screenshot.png or /screenshot.qoi)
+#define SCREENSHOT_SERVER_ENABLED 1
+#define SCREENSHOT_PORT 80
+#define SCREENSHOT_STRIPE_LINES 16     // Lines copied per LVGL lock hold (16 lines = 25 KB, well under 1 ms)
+#define SCREENSHOT_CHUNK_SIZE 1460     // HTTP chunk size, one TCP segment
+#define SCREENSHOT_TASK_CORE 0
+
+// Live mirror over WebSocket (viewer page at /mirror on the screenshot server)
+// Off by default: the socket is unauthenticated, anyone on the LAN could watch the screen and
+// inject touches. Development builds enable it with -DMIRROR_ENABLED=1
+#ifndef MIRROR_ENABLED
+#define MIRROR_ENABLED 0
+#endif
+#define MIRROR_PORT 81
+#define MIRROR_RING_SIZE (256 * 1024)  // PSRAM queue of encoded deltas, overflow triggers a keyframe
+#define MIRROR_TX_SIZE (32 * 1024)     // PSRAM batch buffer for one WebSocket message
+#define MIRROR_BAND_PIXELS 2048        // Areas are encoded in bands of at most this many pixels
+#define MIRROR_KEYFRAME_LINES 8        // Framebuffer lines encoded per LVGL lock hold for keyframes
+#define MIRROR_ACK_SLOTS 32            // Frames in flight tracked for ack latency
+#define MIRROR_TASK_CORE 0
+
+// LVGL heap (LV_STDLIB_CUSTOM, see lvgl_heap.h)
+#define LVGL_HEAP_SRAM_SIZE (64 * 1024)  // Internal SRAM arena for small LVGL allocations
+#define LVGL_HEAP_SMALL_MAX 512          // Larger allocations go straight to PSRAM
+
+// Font store (fonts loaded on demand from LittleFS, see tools/make_fonts.sh)
+#define FONT_STORE_DIR "/fonts"                 // <dir>/<name>_<size>.bin on LittleFS
+#define FONT_STORE_MAX 12                       // Distinct name/size pairs that can be loaded
+#define FONT_GLYPH_CACHE_SIZE (256 * 1024)      // PSRAM for decompressed A8 glyph bitmaps
+
+// Build with -DHOMEPANEL_BENCHMARK to run the display benchmarks once at boot
+#define BENCHMARK_ITERATIONS 20
 
 // Preferences namespaces
 #define PREFS_NAMESPACE "homepanel"        // Machine configurations
@@ -0,0 +1,66 @@
+#ifndef ASSET_STORE_H
+#define ASSET_STORE_H
+
+#include <lvgl.h>
+#include <esp_partition.h>
+#include <esp_idf_version.h>
+#if ESP_IDF_VERSION_MAJOR < 5
+#include <esp_spi_flash.h>
+#endif
+#include "config.h"
+
+// Pre-converted LVGL images in the memory-mapped "assets" partition (built by tools/build_assets.py)
+// The image descriptors point straight into flash, so drawing needs no decode and no RAM copy
+class AssetStore {
+public:
+    // Map the partition and index its images, false if it is missing or empty
+    static bool init();
+
+    // Image by name (file name without extension), nullptr if not present
+    static const lv_image_dsc_t *get(const char *name);
+
+    static uint16_t count() { return asset_count; }
+
+private:
+    // Partition layout, must match tools/build_assets.py
+    struct Header {
+        char magic[4];          // "HPAS"
+        uint16_t version;
+        uint16_t count;
+        uint32_t total_size;
+        uint32_t reserved;
+    };
+
+    struct Entry {
+        char name[32];
+        uint32_t offset;
+        uint32_t size;
+        uint16_t width;
+        uint16_t height;
+        uint8_t format;         // FORMAT_*
+        uint8_t reserved0[3];
+        uint32_t stride;
+        uint8_t reserved1[12];
+    };
+
+    static_assert(sizeof(Header) == 16, "asset header layout");
+    static_assert(sizeof(Entry) == 64, "asset entry layout");
+
+    enum {
+        FORMAT_RGB565 = 0,
+        FORMAT_RGB565A8 = 1,
+    };
+
+    static const Entry *entries;
+    static lv_image_dsc_t *images;
+    static uint16_t asset_count;
+#if ESP_IDF_VERSION_MAJOR >= 5
+    static esp_partition_mmap_handle_t mmap_handle;
+#else
+    static spi_flash_mmap_handle_t mmap_handle;
+#endif
+
+    static void consoleAssets(const char *args);
+};
+
+#endif // ASSET_STORE_H
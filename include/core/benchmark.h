@@ -0,0 +1,41 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <lvgl.h>
+
+// On-device display benchmarks, results are printed over Serial
+// Enabled with -DHOMEPANEL_BENCHMARK (see platformio.ini), run once after ui_init()
+class Benchmark {
+public:
+    // Run every benchmark below
+    static void runAll();
+
+    // Cost of the RGB565 byte swap pass that used to run on every flushed pixel
+    static void runSwapBenchmark();
+
+    // Full-screen refreshes of the active screen through the real flush path
+    static void runFrameBenchmark();
+
+    // Frame time and PSRAM traffic across draw buffer stripe heights and placements
+    static void runStripeBenchmark();
+
+    // PIE draw kernels against their scalar references (correctness and speed)
+    static void runKernelBenchmark();
+
+    // Full-screen refreshes of ui_Screen1 with the keyboard shown (the heaviest screen state),
+    // compare builds with different LV_DRAW_SW_DRAW_UNIT_CNT for the multi-core speedup
+    static void runKeyboardBenchmark();
+
+    // Label-heavy screen drawn with the built-in font, then with a file font from FontStore
+    // with a cold and a warm glyph cache
+    static void runLabelBenchmark();
+
+    // Scripted UI scenarios checked against scenario_budgets.h (see ScenarioBench)
+    static void runScenarioBenchmark();
+
+private:
+    // Invalidate the whole active screen and refresh it, returns elapsed microseconds
+    static uint32_t timeFullRefresh(lv_display_t* disp);
+};
+
+#endif // BENCHMARK_H
@@ -4,6 +4,16 @@
 #include "display_driver.h"
 #include "power_manager.h"
 #include "touch_driver.h"
+#include "touch_latency.h"
+#include "i2c_bus.h"
+#include "dynamic_power.h"
+#include "lvgl_heap.h"
+#include "image_cache.h"
+#include "asset_store.h"
+#include "font_store.h"
+#include "wifi_driver.h"
+#include "screenshot_server.h"
+#include "mirror_server.h"
 
 int core_init();
 
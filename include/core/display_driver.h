@@ -4,22 +4,39 @@
 #define DISPLAY_DRIVER_H
 
 #include <lvgl.h>
+#include "config.h"
+
+// Bytes per pixel in the draw buffers (RGB565_SWAPPED), lv_color_t is 3 bytes in LVGL 9
+#define DRAW_BUF_PX_SIZE lv_color_format_get_size(LV_COLOR_FORMAT_RGB565)
+
+#ifdef HOMEPANEL_NATIVE
+// Host build: no panel, LVGL renders into a memory framebuffer (src/native/display_driver_native.cpp)
+class LGFX;
+#else
 #include <LovyanGFX.hpp>
 #include <lgfx/v1/platforms/esp32s3/Panel_RGB.hpp>
 #include <lgfx/v1/platforms/esp32s3/Bus_RGB.hpp>
 #include <lgfx/v1/touch/Touch_GT911.hpp>
-#include "config.h"
+
+// Panel_RGB with access to the framebuffer that Bus_RGB scans out,
+// so LVGL can render into it directly (DISPLAY_RENDER_DIRECT)
+class Panel_RGB_FB : public lgfx::Panel_RGB
+{
+public:
+  uint16_t* getFrameBuffer(void) { return (uint16_t*)_frame_buffer; }
+};
 
 // LovyanGFX configuration for Elecrow CrowPanel 7"
 class LGFX : public lgfx::LGFX_Device
 {
 public:
   lgfx::Bus_RGB     _bus_instance;
-  lgfx::Panel_RGB   _panel_instance;
+  Panel_RGB_FB      _panel_instance;
   lgfx::Touch_GT911 _touch_instance;
 
   LGFX(void);
 };
+#endif
 
 // Display driver class
 class DisplayDriver {
@@ -29,23 +46,71 @@ public:
     lv_display_t* getDisplay() { return disp; }
     
     // Direct screen buffer access for screenshots
+#ifdef HOMEPANEL_NATIVE
+    LGFX* getLCD() { return nullptr; }
+    
+    // Memory framebuffer standing in for the panel (RGB565_SWAPPED, SCREEN_WIDTH stride)
+    const uint16_t* getFrameBuffer() { return framebuffer; }
+    
+    // The host LVGL tick only moves when advanced, so timers and animations replay identically
+    static void advanceTick(uint32_t ms) { tick_ms += ms; }
+#else
     LGFX* getLCD() { return &lcd; }
+#endif
     
     // Backlight control (brightness 0-100 percentage, or use setBacklightOn/Off for simple on/off)
+    // setBacklight and setBacklightOff are instant and cancel a fade in progress
     void setBacklight(uint8_t brightness_percent);
+    
+    // Ramp to brightness_percent over duration_ms and return at once: LEDC hardware fade on
+    // BACKLIGHT_PWM boards, esp_timer steps through the I2C bus task on BACKLIGHT_I2C boards
+    void fadeBacklight(uint8_t brightness_percent, uint32_t duration_ms);
     void setBacklightOn();
     void setBacklightOff();
     
     // Power management - deep sleep preparation
     void powerDown();
     
+    // Return once the last flushed area is in the panel framebuffer (partial mode copies it
+    // on the flush task, direct mode is already done when the refresh returns)
+    void waitForFlush();
+    
+    // (Re)allocate both draw buffers (DISPLAY_RENDER_PARTIAL only)
+    // internal = true places them in internal DMA-capable SRAM, otherwise PSRAM
+    // On failure the previous buffers stay installed
+    bool allocDrawBuffers(uint32_t lines, bool internal);
+    uint32_t getBufferLines() { return buffer_lines; }
+    bool isBufferInternal() { return buffer_internal; }
+    
+    // Largest stripe height that fits in internal SRAM while leaving WIFI_HEAP_RESERVE free,
+    // 0 if not even STRIPE_LINES_MIN fits
+    static uint32_t autoStripeLines();
+    
+    // Called from the flush callback (UI task) with each rendered area before it is copied out
+    // px points at the area's first pixel (RGB565_SWAPPED), stride is in pixels
+    typedef void (*FlushObserver)(const lv_area_t *area, const uint16_t *px, uint32_t stride);
+    static void setFlushObserver(FlushObserver observer) { flush_observer = observer; }
+    static FlushObserver getFlushObserver() { return flush_observer; }
+    
 private:
+#ifdef HOMEPANEL_NATIVE
+    uint16_t *framebuffer;
+    static uint32_t tick_ms;
+#else
     LGFX lcd;
+#endif
     lv_display_t *disp;
     lv_color_t *disp_draw_buf;
     lv_color_t *disp_draw_buf2;
+    uint32_t buffer_lines;
+    bool buffer_internal;
+    
+    static FlushObserver flush_observer;
     
+    static uint32_t lv_tick_cb();
     static void my_disp_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map);
+    static void my_flush_wait(lv_display_t *disp);
+    static void flush_task(void *param);
 };
 
 #endif // DISPLAY_DRIVER_H
@@ -0,0 +1,51 @@
+#ifndef DRAW_SW_PIE_H
+#define DRAW_SW_PIE_H
+
+// RGB565 kernels for LVGL's software renderer
+// Plugged in through LV_USE_DRAW_SW_ASM = LV_DRAW_SW_ASM_CUSTOM (see lv_conf.h), so this header
+// is included from LVGL's C sources and must stay C compatible
+//
+// Only the solid fill and the opaque same-order copy are hooked, both on the ESP32-S3 PIE 128-bit
+// vector unit. Translucent fills (the home bar's opacity blend), copies between byte orders and
+// LV_DRAW_SW_RGB565_SWAP have no PIE version and are out of scope here: they are not hooked and
+// run LVGL's own C code
+//
+// PIE q registers are coprocessor state: ESP-IDF saves them lazily on a context switch, like the
+// FPU, and pins a task to its core on first use. That is what makes the kernels safe with the
+// two LVGL draw threads (LV_DRAW_SW_DRAW_UNIT_CNT), test/test_draw_sw_pie checks it on device.
+// -DHP_DISABLE_PIE builds the C paths only
+//
+// Every kernel has a plain scalar reference, test/test_draw_sw_pie checks the hooks against
+// the expected pixels on random input
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Row kernels (px_cnt pixels, no alignment requirements)
+void hp_fill16(uint16_t *dst, uint32_t px_cnt, uint16_t color);
+void hp_copy16(uint16_t *dst, const uint16_t *src, uint32_t px_cnt);
+
+// Scalar references
+void hp_ref_fill16(uint16_t *dst, uint32_t px_cnt, uint16_t color);
+void hp_ref_copy16(uint16_t *dst, const uint16_t *src, uint32_t px_cnt);
+
+// LVGL draw-SW hooks, return LV_RESULT_INVALID to fall back to LVGL's C implementation
+lv_result_t hp_blend_color_to_rgb565(lv_draw_sw_blend_fill_dsc_t *dsc, bool swapped);
+lv_result_t hp_blend_rgb565_to_rgb565(lv_draw_sw_blend_image_dsc_t *dsc, bool src_swapped, bool dest_swapped);
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565(dsc)                         hp_blend_color_to_rgb565(dsc, false)
+#define LV_DRAW_SW_RGB565_BLEND_NORMAL_TO_RGB565(dsc)                 hp_blend_rgb565_to_rgb565(dsc, false, false)
+
+#define LV_DRAW_SW_COLOR_BLEND_TO_RGB565_SWAPPED(dsc)                 hp_blend_color_to_rgb565(dsc, true)
+#define LV_DRAW_SW_RGB565_SWAPPED_BLEND_NORMAL_TO_RGB565_SWAPPED(dsc) hp_blend_rgb565_to_rgb565(dsc, true, true)
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif // DRAW_SW_PIE_H
@@ -0,0 +1,71 @@
+#ifndef DYNAMIC_POWER_H
+#define DYNAMIC_POWER_H
+
+#include <Arduino.h>
+#include <esp_pm.h>
+#include "config.h"
+
+// Dynamic frequency scaling and automatic light sleep (esp_pm)
+// The CPU runs at PM_MIN_CPU_FREQ_MHZ unless one of the PM locks below asks for the maximum
+// (f_cpu in platformio.ini):
+//   render - a UI task pass (input, timers, rendering)
+//   flush  - a partial-mode area copy on the flush task
+//   touch  - from a press until the touch poll goes back to its idle period
+// Light sleep is blocked while the panel is lit, the RGB scanout stops in light sleep, so it
+// only happens in PowerManager's SCREEN_OFF
+// Residency ('pm' console command) is counted from the lock state this firmware requests;
+// other holders (Wi-Fi) may keep the CPU faster than counted
+class DynamicPower {
+public:
+    static void init();
+
+    // UI task, around one pass of the loop
+    static void renderBegin();
+    static void renderEnd();
+
+    // Display driver: area handed to the flush task / copy done
+    static void flushBegin();
+    static void flushEnd();
+
+    // Touch driver: touch poll switched between its active and idle period
+    static void setTouchActive(bool active);
+
+    // PowerManager: panel lit (no light sleep) or off
+    static void setDisplayOn(bool on);
+
+    // Touch driver INT interrupt
+    static void touchInterruptFromISR();
+
+    static void dump();
+    static void reset();
+
+private:
+    enum Mode {
+        MODE_MAX,      // A CPU_FREQ_MAX lock held
+        MODE_MIN,      // Min frequency, panel lit
+        MODE_SLEEP,    // Min frequency or light sleep, panel off
+        MODE_COUNT,
+    };
+
+    static esp_pm_lock_handle_t render_lock;
+    static esp_pm_lock_handle_t flush_lock;
+    static esp_pm_lock_handle_t touch_lock;
+    static esp_pm_lock_handle_t display_lock;
+    static bool configured;
+    static bool light_sleep;
+    static bool touch_active;
+    static bool display_on;
+    static volatile bool touch_wake_armed;
+    static uint32_t max_holders;
+    static uint64_t residency_us[MODE_COUNT];
+    static uint64_t since_us;
+
+    static void acquireMax(esp_pm_lock_handle_t lock);
+    static void releaseMax(esp_pm_lock_handle_t lock);
+    static Mode currentMode();
+    static void account();
+    static void armTouchWake(bool arm);
+    static void consolePm(const char *args);
+};
+
+#endif // DYNAMIC_POWER_H
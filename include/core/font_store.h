@@ -0,0 +1,53 @@
+#ifndef FONT_STORE_H
+#define FONT_STORE_H
+
+#include <lvgl.h>
+#include "config.h"
+
+// Fonts loaded on first use from LVGL binary font files on LittleFS (data/fonts/<name>_<size>.bin,
+// generated by tools/make_fonts.sh), instead of being compiled into the firmware
+//
+// Glyph bitmaps are kept decompressed (A8) in a bounded LRU cache in PSRAM, shared by all file
+// fonts, so each glyph is decompressed once rather than on every draw
+//
+//     lv_obj_set_style_text_font(label, FontStore::get("montserrat", 20), 0);
+class FontStore {
+public:
+    // Mount LittleFS and create the glyph cache, call after lv_init()
+    static void init();
+
+    // Font by family and pixel size, loaded on first request
+    // Falls back to LV_FONT_DEFAULT if the file is missing, never returns null
+    static const lv_font_t *get(const char *name, uint8_t size);
+
+    // Free every cached glyph (benchmarks use it to measure cold text rendering)
+    static void dropGlyphs();
+
+    static uint32_t getHits() { return hits; }
+    static uint32_t getMisses() { return misses; }
+
+    static void dump();
+    static void resetStats();
+
+private:
+    struct Font {
+        char name[24];
+        uint8_t size;
+        lv_font_t *font;           // nullptr if loading failed
+        const void *(*get_bitmap)(lv_font_glyph_dsc_t *g_dsc, lv_draw_buf_t *draw_buf);
+        uint32_t load_us;
+    };
+
+    static Font fonts[FONT_STORE_MAX];
+    static uint8_t font_count;
+    static lv_cache_t *glyph_cache;
+
+    static volatile uint32_t hits;
+    static volatile uint32_t misses;
+
+    static const void *cachedGetBitmap(lv_font_glyph_dsc_t *g_dsc, lv_draw_buf_t *draw_buf);
+    static void cachedRelease(const lv_font_t *font, lv_font_glyph_dsc_t *g_dsc);
+    static void consoleFonts(const char *args);
+};
+
+#endif // FONT_STORE_H
@@ -0,0 +1,65 @@
+#ifndef FRAME_STATS_H
+#define FRAME_STATS_H
+
+#include <lvgl.h>
+#include "histogram.h"
+#include "config.h"
+
+// Per-frame render/flush instrumentation, always on
+// Collected from LVGL display events and the flush path into fixed-bucket histograms,
+// dumped with the 'stats' console command (and every FRAME_STATS_INTERVAL_MS if set)
+class FrameStats {
+public:
+    // Register display events, the report timer and console commands
+    static void init(lv_display_t *disp);
+
+    // Flush path hooks (UI task): a render segment ends when an area is flushed or LVGL waits
+    // for a buffer, and starts again when the flush call or the wait returns
+    static void flushBegin(const lv_area_t *area);
+    static void flushEnd();
+    static void waitBegin();
+    static void waitEnd();
+
+    // Time spent copying an area into the framebuffer (may be called from the flush task)
+    static void addCopyTime(uint32_t us);
+    static uint64_t getCopyTimeTotalUs() { return copy_total_us; }
+
+    static void dump();
+    static void reset();
+
+    // Small on-screen overlay with p50/p95 frame and render times
+    static void setOverlay(bool enabled);
+
+private:
+    // Current frame
+    static uint32_t frame_start_us;
+    static uint32_t last_frame_start_us;
+    static bool frame_rendered;
+    static uint32_t segment_start_us;
+    static uint32_t frame_render_us;
+    static uint32_t frame_wait_us;
+    static volatile uint32_t frame_copy_us;
+    static uint32_t frame_pixels;
+    static uint32_t frame_areas;
+    static uint64_t copy_total_us;
+
+    // Histograms over all frames since the last reset
+    static Histogram frame_time;
+    static Histogram render_time;
+    static Histogram wait_time;
+    static Histogram copy_time;
+    static Histogram frame_interval;
+    static Histogram pixels;
+    static Histogram areas;
+
+    static lv_obj_t *overlay;
+    static lv_timer_t *overlay_timer;
+
+    static void event_cb(lv_event_t *e);
+    static void report_timer_cb(lv_timer_t *timer);
+    static void overlay_timer_cb(lv_timer_t *timer);
+    static void printHistogram(const char *name, const Histogram &h, const char *unit, float scale);
+    static void consoleStats(const char *args);
+};
+
+#endif // FRAME_STATS_H
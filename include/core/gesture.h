@@ -0,0 +1,80 @@
+#ifndef GESTURE_H
+#define GESTURE_H
+
+#include <cstdint>
+#include "config.h"
+
+// One finger as reported by the touch controller
+struct TouchPoint {
+    uint8_t id;   // Track id, stable while the finger stays down
+    int16_t x;
+    int16_t y;
+};
+
+// A recognized gesture, passed as the event parameter of TouchDriver::gestureEvent()
+struct Gesture {
+    enum Type : uint8_t {
+        PINCH,             // Two fingers moving apart or together, BEGIN / UPDATE... / END
+        TWO_FINGER_SWIPE,  // Two fingers moving together in one direction
+        LONG_PRESS,        // One finger held still for GESTURE_LONG_PRESS_MS
+        EDGE_SWIPE,        // One finger starting at a screen edge and moving inward
+    };
+    enum Phase : uint8_t { BEGIN, UPDATE, END };  // Single-shot gestures are always END
+    enum Dir : uint8_t { LEFT, RIGHT, UP, DOWN };
+
+    Type type;
+    Phase phase;
+    Dir dir;           // Swipes: direction of travel
+    int16_t start_x;   // Where the gesture started (centroid for two fingers)
+    int16_t start_y;
+    int16_t x;         // Current position (centroid for two fingers)
+    int16_t y;
+    int32_t scale_q8;  // Pinch: finger distance / distance at BEGIN, 256 = 1.0
+};
+
+// Incremental gesture recognizer, fed one sample per touch read, no allocation
+//
+//     TouchPoint points[TOUCH_MAX_POINTS];
+//     Gesture out[GestureRecognizer::MAX_OUT];
+//     uint8_t n = recognizer.update(points, count, millis(), out);
+class GestureRecognizer {
+public:
+    static const uint8_t MAX_OUT = 2;  // Most gestures one sample can produce (a pinch END and a swipe)
+
+    GestureRecognizer() { reset(); }
+
+    // Feed the points currently down, returns how many gestures were written to out
+    uint8_t update(const TouchPoint *points, uint8_t count, uint32_t now_ms, Gesture *out);
+
+    // Two fingers are (or were, until all are lifted) down: the single pointer given to LVGL
+    // should hold still so the content under the fingers does not scroll or click
+    bool isMultiTouch() const { return mode == TWO || mode == PINCHING || mode == MULTI_DONE; }
+
+    void reset();
+
+private:
+    enum Mode : uint8_t {
+        NONE,
+        ONE,         // One finger, may become a long press or an edge swipe
+        ONE_DONE,    // One finger, its gesture was reported or it moved too far for one
+        TWO,         // Two fingers, not yet a pinch or a swipe
+        PINCHING,
+        MULTI_DONE,  // Two-finger gesture reported, wait for all fingers to lift
+    };
+
+    Mode mode;
+    uint32_t start_ms;
+    int16_t start_x;
+    int16_t start_y;
+    bool at_edge;
+    Gesture::Dir edge_dir;  // Inward direction from the edge the finger started on
+    float start_dist;
+    int16_t last_x;
+    int16_t last_y;
+    int32_t last_scale_q8;
+
+    static Gesture::Dir dominantDir(int32_t dx, int32_t dy);
+    Gesture make(Gesture::Type type, Gesture::Phase phase, int16_t x, int16_t y) const;
+};
+
+#endif // GESTURE_H
@@ -0,0 +1,41 @@
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include <cstdint>
+
+// Fixed-bucket histogram with percentile queries, no allocation
+// Bucket upper bounds are given as a static ascending table, the last bucket catches everything above
+class Histogram {
+public:
+    static constexpr uint8_t MAX_BUCKETS = 32;
+
+    Histogram(const uint32_t *bounds, uint8_t bucket_count);
+
+    void add(uint32_t value);
+    void reset();
+
+    // Upper bound of the bucket holding the p-th percentile (exact max for the last bucket)
+    uint32_t percentile(uint8_t p) const;
+
+    uint32_t count() const { return samples; }
+    uint32_t max() const { return max_value; }
+    uint32_t mean() const { return samples ? (uint32_t)(sum / samples) : 0; }
+
+    // Common bucket tables
+    static const uint32_t TIME_US_BOUNDS[];     // 100 us .. 500 ms
+    static const uint8_t TIME_US_BUCKETS;
+    static const uint32_t PIXEL_BOUNDS[];       // 1 px .. full screen
+    static const uint8_t PIXEL_BUCKETS;
+    static const uint32_t COUNT_BOUNDS[];       // 0 .. 32
+    static const uint8_t COUNT_BUCKETS;
+
+private:
+    const uint32_t *bounds;
+    uint8_t bucket_count;
+    uint32_t buckets[MAX_BUCKETS];
+    uint32_t samples;
+    uint32_t max_value;
+    uint64_t sum;
+};
+
+#endif // HISTOGRAM_H
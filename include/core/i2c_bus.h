@@ -0,0 +1,79 @@
+#ifndef I2C_BUS_H
+#define I2C_BUS_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "histogram.h"
+#include "config.h"
+
+// Arbiter for the I2C port shared by the GT911 and, on the Advance board, the STC8H1K28
+// (backlight and buzzer). After boot a single task owns the bus and runs, in this order:
+//   1. the touch poll, every touch period or right away when kicked (INT line)
+//   2. coalesced writes, one slot per purpose, only the latest value of a slot is sent
+// Nobody else waits on the bus: writes are fire-and-forget and the touch poll hands its
+// results to the UI task itself. Transaction times per device are dumped with 'i2c'
+class I2cBus {
+public:
+    enum Slot : uint8_t {
+        SLOT_BACKLIGHT,
+        SLOT_BUZZER,
+        SLOT_COUNT,
+    };
+
+    typedef void (*PollFn)();
+
+    // Start the bus task on the port LovyanGFX set up for the touch panel
+    static void start(int port);
+
+    // Touch driver: poll function run on the bus task every period_ms, ahead of any write
+    static void setTouchPoller(PollFn fn, uint32_t period_ms);
+    static void setTouchPeriod(uint32_t period_ms);
+
+    // Run the touch poll now
+    static void kickTouch();
+    static void kickTouchFromISR();
+
+    // Fire-and-forget write of one byte, replaces a write still pending in the same slot
+    static void post(Slot slot, uint8_t addr, uint8_t value, uint32_t freq);
+
+    // Wait until every posted write is on the wire (deep sleep entry), false on timeout
+    static bool flush(uint32_t timeout_ms);
+
+    // Transactions for the touch poll (bus task only), timed per device
+    static bool writeRead(uint8_t addr, const uint8_t *wbuf, uint8_t wlen, uint8_t *rbuf, uint8_t rlen, uint32_t freq);
+    static bool write(uint8_t addr, const uint8_t *wbuf, uint8_t wlen, uint32_t freq);
+
+    static void dump();
+    static void reset();
+
+private:
+    struct Pending {
+        bool valid;
+        uint8_t addr;
+        uint8_t value;
+        uint32_t freq;
+    };
+
+    struct Device {
+        uint8_t addr;
+        uint32_t errors;
+        Histogram time;  // Transaction time, us
+    };
+
+    static int port;
+    static TaskHandle_t task_handle;
+    static PollFn poller;
+    static volatile uint32_t poll_period_ms;
+    static volatile bool touch_kicked;
+    static Pending slots[SLOT_COUNT];
+    static uint32_t coalesced;  // Writes replaced before they were sent
+    static Device devices[I2C_BUS_MAX_DEVICES];
+    static uint8_t device_count;
+
+    static void run(void *param);
+    static void record(uint8_t addr, uint32_t elapsed_us, bool ok);
+    static void consoleI2c(const char *args);
+};
+
+#endif // I2C_BUS_H
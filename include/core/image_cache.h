@@ -0,0 +1,54 @@
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+#include <lvgl.h>
+#include "config.h"
+
+// Decoded image cache: LVGL's LRU image cache (budget LV_CACHE_DEF_SIZE, resizable at runtime)
+// with decoded pixels placed in PSRAM, hit/miss/eviction counters and pinning of the images
+// on the active screen so switching between visible content never re-decodes them
+class ImageCache {
+public:
+    // Call after lv_init()
+    static void init();
+
+    // Keep an image decoded until unpin() (returns false if the pin table is full or decoding failed)
+    static bool pin(const void *src);
+    static void unpin(const void *src);
+
+    // Change the byte budget, entries over the new budget are evicted right away
+    static void setBudget(uint32_t bytes);
+
+    static void dump();
+    static void resetStats();
+
+private:
+    struct Pin {
+        const void *src;
+        lv_image_decoder_dsc_t dsc;
+        bool automatic;  // Pinned because it is on the active screen
+        bool seen;       // Found again by the current scan of the active screen
+    };
+
+    static Pin pins[IMAGE_CACHE_MAX_PINS];
+    static uint8_t pin_count;
+
+    static volatile uint32_t hits;
+    static volatile uint32_t misses;
+    static volatile uint32_t evictions;
+
+    static lv_cache_class_t counted_class;
+    static const lv_cache_class_t *lru_class;
+
+    static lv_cache_entry_t *cacheGet(lv_cache_t *cache, const void *key, void *user_data);
+    static lv_cache_entry_t *cacheGetVictim(lv_cache_t *cache, void *user_data);
+    static void *buf_malloc(size_t size, lv_color_format_t cf);
+    static void buf_free(void *buf);
+    static void pinScreen(lv_obj_t *screen);
+    static void pinTree(lv_obj_t *obj);
+    static void unpinAutomatic(bool unseen_only);
+    static void screen_timer_cb(lv_timer_t *timer);
+    static void consoleCache(const char *args);
+};
+
+#endif // IMAGE_CACHE_H
@@ -0,0 +1,30 @@
+#ifndef LVGL_HEAP_H
+#define LVGL_HEAP_H
+
+#include <lvgl.h>
+#include "config.h"
+
+// Two-tier heap behind lv_malloc() (LV_USE_STDLIB_MALLOC = LV_STDLIB_CUSTOM)
+//
+// Small allocations (objects, styles, event descriptors, timers, strings) come from an arena in
+// internal SRAM, since they are read on every draw and event. Anything larger than
+// LVGL_HEAP_SMALL_MAX (draw buffers, layers, decoded images) goes to PSRAM, as do small
+// allocations once the arena is full
+class LvglHeap {
+public:
+    // Register the console command, the heap itself is set up by lv_init()
+    static void init();
+
+    // Bytes currently allocated through lv_malloc(), both tiers
+    static size_t usedBytes();
+
+    static void dump();
+
+    // Restart the high-water marks and fallback counter from the current usage
+    static void resetPeak();
+
+private:
+    static void consoleMem(const char *args);
+};
+
+#endif // LVGL_HEAP_H
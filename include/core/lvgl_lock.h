@@ -0,0 +1,23 @@
+#ifndef LVGL_LOCK_H
+#define LVGL_LOCK_H
+
+#include <lvgl.h>
+
+// Scoped LVGL lock for code running outside the UI loop (Wi-Fi, WebSocket and server tasks)
+// lv_timer_handler() takes the same recursive lock internally, so every LVGL call made from
+// another task must hold it:
+//
+//     {
+//         LvglLock lock;
+//         lv_label_set_text(label, "Connected");
+//     }
+class LvglLock {
+public:
+    LvglLock() { lv_lock(); }
+    ~LvglLock() { lv_unlock(); }
+
+    LvglLock(const LvglLock&) = delete;
+    LvglLock& operator=(const LvglLock&) = delete;
+};
+
+#endif // LVGL_LOCK_H
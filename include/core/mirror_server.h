@@ -0,0 +1,70 @@
+#ifndef MIRROR_SERVER_H
+#define MIRROR_SERVER_H
+
+#include <WebSocketsServer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/ringbuf.h>
+#include "display_driver.h"
+#include "histogram.h"
+#include "config.h"
+
+// Live framebuffer mirror over WebSocket (ws://<panel>:MIRROR_PORT/, viewer page at /mirror)
+//
+// Every area LVGL flushes is RLE encoded on RGB565 into a PSRAM ring buffer and sent by the mirror
+// task, so cost scales with the changed pixels. Clients get a full keyframe on connect, on request,
+// or when the ring overflowed, and can send touches back into the TouchDriver input path.
+//
+// Wire format, all integers little endian, a WebSocket message holds one or more records:
+//   server -> client
+//     'A' x:u16 y:u16 w:u16 h:u16 len:u32 rle[len]   Area, w*h pixels row by row
+//     'F' seq:u32 bytes:u32                           End of frame, bytes = delta bytes in this frame
+//   client -> server
+//     'T' x:u16 y:u16 pressed:u8                      Touch
+//     'F' seq:u32                                     Frame acknowledge (latency measurement)
+//     'K'                                             Request a keyframe
+//   RLE: control byte c, c & 0x80 -> (c & 0x7F) + 1 copies of the next pixel,
+//        otherwise c + 1 literal pixels follow. Pixels are 2 bytes, RGB565 high byte first.
+class MirrorServer {
+public:
+    static void init(DisplayDriver *driver);
+
+    static void dump();
+    static void reset();
+
+private:
+    static DisplayDriver *display;
+    static WebSocketsServer *ws;
+    static RingbufHandle_t ring;
+    static StaticRingbuffer_t ring_struct;
+    static uint8_t *tx;
+    static size_t tx_len;
+    static volatile uint8_t clients;
+    static volatile bool keyframe_needed;
+
+    // Frame accounting (UI task)
+    static uint32_t frame_seq;
+    static uint32_t frame_bytes;
+    static uint32_t frame_sent_us[MIRROR_ACK_SLOTS];
+
+    // Statistics
+    static Histogram bytes_per_frame;
+    static Histogram ack_latency;
+    static uint32_t dropped;
+    static uint32_t keyframes;
+
+    static void flushObserver(const lv_area_t *area, const uint16_t *px, uint32_t stride);
+    static void event_cb(lv_event_t *e);
+    static void wsEvent(uint8_t num, WStype_t type, uint8_t *payload, size_t length);
+    static void task(void *param);
+    static void sendKeyframe();
+    static void put(const void *data, size_t len);
+    static void flushTx();
+    static void handlePage();
+    static void consoleMirror(const char *args);
+};
+
+// RLE encode a w x h area whose rows are stride pixels apart, returns the encoded size
+// Worst case output is 3 bytes per pixel
+size_t mirror_rle_encode(const uint16_t *px, uint32_t w, uint32_t h, uint32_t stride, uint8_t *out);
+
+#endif // MIRROR_SERVER_H
@@ -7,6 +7,8 @@
 #include "display_driver.h"
 
 // Power management for battery-powered operation
+// State and stats are owned by the UI task pass and guarded by the LVGL lock (UiTask::pass),
+// other tasks call in with LvglLock held
 class PowerManager {
 public:
     // Initialize power manager with display driver reference
@@ -18,6 +20,21 @@ public:
     // Call this periodically from main loop to handle power management
     static void update(int machine_state);
 
+    // UI task, right after lv_timer_handler(): a wake from SCREEN_OFF requested during the pass
+    // (touch read) redraws the screen and lights the backlight here, outside the indev timer
+    static void finishWake();
+
+    // Milliseconds until the next state transition is due (UINT32_MAX if none)
+    static uint32_t msUntilNextDeadline();
+
+    // UI task: time spent working (not sleeping) in one pass, counted against the current state
+    static void addBusyTime(uint32_t busy_us);
+
+    // Time, UI task busy share and frames rendered per state, 'power' console command
+    // (current draw has to be measured at the supply, the board has no sensor for it)
+    static void dumpStats();
+    static void resetStats();
+
     // Load settings from preferences
     static void loadSettings();
 
@@ -52,6 +69,12 @@ public:
     static PowerState getCurrentState() { return current_state; }
 
 private:
+    struct StateStats {
+        uint64_t time_us;
+        uint64_t busy_us;
+        uint32_t frames;     // Frames that rendered something
+    };
+
     static DisplayDriver* display_driver;
     static bool enabled;
     static uint32_t dim_timeout_sec;          // Time until dimming (seconds)
@@ -62,8 +85,15 @@ private:
     static uint32_t last_activity_ms;         // Last touch/activity timestamp
     static PowerState current_state;
     static bool state_changed;                // Track if we just changed state
+    static StateStats state_stats[3];         // Indexed by PowerState
+    static uint32_t state_since_us;           // Start of the current state's unaccounted time
+    static bool wake_pending;                 // Left SCREEN_OFF, redraw and backlight still to do
 
     // Internal state management
+    static void setState(PowerState state);
+    static void applyRenderPolicy(PowerState state);
+    static void render_event_cb(lv_event_t *e);
+    static void consolePower(const char *args);
     static void enterFullBrightness();
     static void enterDimmed();
     static void enterScreenOff();
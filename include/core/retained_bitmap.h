@@ -0,0 +1,58 @@
+#ifndef RETAINED_BITMAP_H
+#define RETAINED_BITMAP_H
+
+#include <lvgl.h>
+#include "config.h"
+
+// Retained rendering for mostly static widget subtrees
+//
+// The subtree is rendered once into a PSRAM bitmap and that bitmap is blitted in its place until
+// something invalidates the area it covers, at which point it is re-rendered at the start of the
+// next refresh. With an opaque backdrop (e.g. a full-screen wallpaper) the backdrop is pre-composed
+// into the bitmap, so translucent overlays are not blended again and LVGL starts drawing at the
+// subtree (the bitmap reports itself as covering), skipping everything underneath.
+//
+//     RetainedBitmap::create(ui_homebar, ui_Background);
+//
+// Children added to the subtree after create() are not retained.
+class RetainedBitmap {
+public:
+    // root: subtree to retain, backdrop: optional static opaque object behind it covering root
+    static RetainedBitmap *create(lv_obj_t *root, lv_obj_t *backdrop = nullptr);
+
+    // Force a re-render at the next refresh
+    void invalidate() { stale = true; }
+
+    static void dump();
+    static void resetStats();
+
+private:
+    lv_obj_t *root;
+    lv_obj_t *backdrop;
+    lv_draw_buf_t *bitmap;
+    lv_area_t area;              // Screen area held by the bitmap
+    bool stale;
+    uint32_t capture_us;         // Cost of the last full render of the area
+
+    static RetainedBitmap pool[RETAINED_BITMAP_MAX];
+    static uint8_t pool_count;
+    static bool capturing;
+
+    // Statistics
+    static uint32_t hit_frames;      // Refreshes that blitted a retained bitmap
+    static uint32_t capture_count;   // Re-renders
+    static uint64_t capture_total_us;
+    static uint64_t saved_total_us;  // Estimated, from the last render cost of the blitted part
+    static bool frame_hit;
+
+    bool capture();
+    static void retainTree(lv_obj_t *obj, RetainedBitmap *rb);
+    static void root_draw_cb(lv_event_t *e);
+    static void child_draw_cb(lv_event_t *e);
+    static void cover_check_cb(lv_event_t *e);
+    static void delete_cb(lv_event_t *e);
+    static void display_event_cb(lv_event_t *e);
+    static void consoleRetained(const char *args);
+};
+
+#endif // RETAINED_BITMAP_H
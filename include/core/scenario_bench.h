@@ -0,0 +1,60 @@
+#ifndef SCENARIO_BENCH_H
+#define SCENARIO_BENCH_H
+
+#include <lvgl.h>
+#include "core/display_driver.h"
+#include "core/scenario_budgets.h"
+
+// Scripted scenarios on the real SquareLine screens, on the panel (Benchmark::runAll) and in the
+// native host build (src/native/main_native.cpp)
+//
+// Each scenario reports frames, ms/frame, pixels flushed and LVGL heap growth and is checked
+// against its budget in scenario_budgets.h. Input goes through the real touch input device and
+// the real keyboard and screen event handlers, frames through the real flush path
+class ScenarioBench {
+public:
+    // Run every scenario in order (they build on each other), returns false if any is over budget
+    // and SCENARIO_BUDGETS_ENFORCED is set
+    // Expects ui_init() to have run, leaves the UI in its boot state
+    static bool runAll();
+
+    // What builds the UI for the cold start scenario (default ui_init), for boards that add
+    // to the SquareLine screens after ui_init()
+    static void setUiInit(void (*init)()) { ui_init_fn = init; }
+
+private:
+    struct Result {
+        uint32_t frames;
+        uint32_t render_us;
+        uint32_t max_frame_us;
+        uint32_t pixels;
+        int32_t heap_bytes;
+    };
+
+    static Result current;
+    static int32_t heap_before;
+    static void (*ui_init_fn)();
+    static uint32_t frame_pixels;
+    static DisplayDriver::FlushObserver chained_observer;
+    static lv_obj_t *bench_screen;
+
+    // Scenario steps
+    static void coldInit();
+    static void tapTextArea();
+    static void typeChars();
+    static void hideKeyboard();
+    static void screenChange();
+
+    // Refresh now and count the frame if anything was flushed
+    static void frame();
+    // Advance time by ms and run LVGL timers (animations), counting any frame they render
+    static void step(uint32_t ms);
+    static void tap(lv_obj_t *obj);
+    static int32_t heapUsed();
+    static void benchScreenInit();
+
+    static bool report(const ScenarioBudget &budget, const Result &r);
+    static void countPixels(const lv_area_t *area, const uint16_t *px, uint32_t stride);
+};
+
+#endif // SCENARIO_BENCH_H
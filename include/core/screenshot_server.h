@@ -0,0 +1,42 @@
+#ifndef SCREENSHOT_SERVER_H
+#define SCREENSHOT_SERVER_H
+
+#include <WebServer.h>
+#include "display_driver.h"
+#include "config.h"
+
+// HTTP screenshot endpoint for remote support
+//   GET /screenshot.png  - browser viewable PNG (stored deflate, no compression)
+//   GET /screenshot.qoi  - QOI, typically 10-50x smaller for UI content
+// The frame is read straight from the panel framebuffer a stripe at a time and encoded while
+// it is sent, so there is never a second full-screen copy and the LVGL lock is only held for
+// the memcpy of one stripe (SCREENSHOT_STRIPE_LINES) into a small internal SRAM buffer
+class ScreenshotServer {
+public:
+    static void init(DisplayDriver *driver);
+
+    // Shared HTTP server, other modules may register their own pages on it
+    static WebServer *getWebServer() { return server; }
+
+private:
+    static DisplayDriver *display;
+    static WebServer *server;
+
+    // Per request state (only one request is served at a time)
+    static uint16_t *stripe;
+    static uint8_t out[SCREENSHOT_CHUNK_SIZE];
+    static size_t out_len;
+    static uint32_t lock_max_us;
+
+    static void task(void *param);
+    static void handlePng();
+    static void handleQoi();
+
+    static bool beginCapture(const char *content_type);
+    static void endCapture(const char *format, uint32_t start_ms);
+    static void copyStripe(uint32_t y, uint32_t lines);
+    static void put(const void *data, size_t len);
+    static void flushOut();
+};
+
+#endif // SCREENSHOT_SERVER_H
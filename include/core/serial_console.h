@@ -0,0 +1,35 @@
+#ifndef SERIAL_CONSOLE_H
+#define SERIAL_CONSOLE_H
+
+#include <cstdint>
+#include "config.h"
+
+// Line based command console on Serial (115200, newline terminated)
+// Modules register their commands at init, handlers run on the console task with the LVGL lock held
+class SerialConsole {
+public:
+    // args points past the command name (never null, may be empty)
+    typedef void (*Handler)(const char *args);
+
+    // Start the console task
+    static void start();
+
+    // Register a command, returns false if the command table is full
+    static bool registerCommand(const char *name, const char *help, Handler handler);
+
+private:
+    struct Command {
+        const char *name;
+        const char *help;
+        Handler handler;
+    };
+
+    static Command commands[CONSOLE_MAX_COMMANDS];
+    static uint8_t command_count;
+
+    static void task(void *param);
+    static void execute(char *line);
+    static void printHelp(const char *args);
+};
+
+#endif // SERIAL_CONSOLE_H
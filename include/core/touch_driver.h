@@ -5,21 +5,61 @@
 
 #include <lvgl.h>
 #include "config.h"
+#include "core/gesture.h"
+#include "core/touch_filter.h"
 
 // Forward declaration
 class LGFX;
 
 // Touch driver class
+// The GT911 is polled on the I2C bus task (I2cBus), the LVGL read callback only takes the latest
+// report, so the UI task never waits on I2C. Polls are gated: while nobody touches the panel,
+// each is a single GT911 status check (or nothing at all with TOUCH_INT wired) at
+// TOUCH_IDLE_POLL_MS, the full point read only runs when a report is waiting or a finger is down
+//
+// The pointer handed to LVGL goes through a TouchFilter (one-euro smoothing and prediction),
+// the 'filter' console command switches it, tunes the prediction and traces raw samples for
+// tools/touch_replay.sh
+//
+// The point read is one burst of all GT911 points; a GestureRecognizer runs on them and sends
+// getGestureEvent() with a const Gesture * parameter to the object under the gesture (and to
+// the active screen), e.g. for pinch-zoom on an image or swipes between screens:
+//
+//     lv_obj_add_event_cb(img, on_gesture, TouchDriver::getGestureEvent(), nullptr);
+//     const Gesture *g = (const Gesture *)lv_event_get_param(e);
 class TouchDriver {
 public:
     TouchDriver();
     bool init(LGFX *lcd);
     lv_indev_t* getInputDevice() { return indev; }
     
+    // Feed a touch from a remote client (mirror) into the same input path as the panel
+    // A local touch on the panel always takes precedence
+    static void injectTouch(int16_t x, int16_t y, bool pressed);
+    
+    // Called by the UI task when woken: reads the input device now if the bus task posted a new
+    // report or a remote touch arrived, instead of waiting out the (slow while idle) read period
+    // Takes the LVGL lock (the UI pass already holds it)
+    static void serviceReadRequest();
+    
+    // Event code of recognized gestures (registered in init)
+    static lv_event_code_t getGestureEvent();
+    
+    // I2C transactions per second while idle and while in use
+    static void dumpStats();
+    static void resetStats();
+    
 private:
     lv_indev_t *indev;
     
     static void my_touchpad_read(lv_indev_t *indev, lv_indev_data_t *data);
+    static void pollGt911();
+    static bool gt911BufferReady();
+    static int gt911ReadPoints(TouchPoint *points);
+    static void dispatchGesture(const Gesture &gesture);
+    static void touch_isr();
+    static void consoleTouch(const char *args);
+    static void consoleFilter(const char *args);
 };
 
 #endif // TOUCH_DRIVER_H
@@ -0,0 +1,57 @@
+#ifndef TOUCH_FILTER_H
+#define TOUCH_FILTER_H
+
+#include <cstdint>
+#include "config.h"
+
+// One-euro filter with velocity prediction for the LVGL pointer, fixed point, no allocation
+//
+// Each axis is low-pass filtered with a cutoff that rises with speed: slow or still fingers get
+// heavy smoothing (no jitter on sliders), fast ones little (no lag when scrolling). The filtered
+// velocity then extrapolates the position predict_ms ahead, to make up for the time between the
+// touch read and the frame reaching the panel.
+//
+// Positions are kept in 1/16 px, velocities in 1/16 px per second
+class TouchFilter {
+public:
+    struct Params {
+        uint32_t min_cutoff_mhz;   // Cutoff of a still finger, in mHz
+        uint32_t beta_x1000;       // Cutoff increase per px/s of speed, in mHz (one-euro beta x 1000)
+        uint32_t dcutoff_mhz;      // Cutoff of the velocity estimate, in mHz
+        uint16_t predict_ms;       // How far ahead to extrapolate, 0 = filter only
+        uint16_t predict_max_px;   // Longest extrapolation, bounds overshoot on sudden stops
+    };
+
+    // Params from config.h (TOUCH_FILTER_* / TOUCH_PREDICT_*)
+    static Params defaults();
+
+    TouchFilter() : params(defaults()) { reset(); }
+    explicit TouchFilter(const Params &p) : params(p) { reset(); }
+
+    void setParams(const Params &p) { params = p; }
+    const Params &getParams() const { return params; }
+
+    // Forget the previous stroke, the next sample passes through unchanged
+    void reset();
+
+    // Feed a new controller sample of a finger that is down, returns the position to report
+    void update(int16_t x, int16_t y, uint32_t t_ms, int16_t *out_x, int16_t *out_y);
+
+private:
+    struct Axis {
+        int32_t pos_q4;
+        int32_t vel_q4;
+        int16_t last_raw;
+    };
+
+    Params params;
+    Axis ax;
+    Axis ay;
+    uint32_t last_ms;
+    bool primed;
+
+    int16_t step(Axis &a, int16_t raw, uint32_t dt_ms, int16_t limit) const;
+    static int32_t alphaQ16(uint32_t cutoff_mhz, uint32_t dt_ms);
+};
+
+#endif // TOUCH_FILTER_H
@@ -0,0 +1,63 @@
+#ifndef TOUCH_LATENCY_H
+#define TOUCH_LATENCY_H
+
+#include <lvgl.h>
+#include "histogram.h"
+#include "config.h"
+
+// Touch-to-photon latency, always on
+// Each new press is followed through three timestamps:
+//   sample   - the GT911 read in my_touchpad_read that saw the press
+//   dispatch - LV_EVENT_PRESSED handled (object handlers such as ui_event_TextArea1 have run)
+//   flush    - the first flushed area of a frame started after the dispatch that overlaps the
+//              watched object (any area if none is watched) has reached the framebuffer
+// The panel shows it at the next scanout, up to one refresh of the LCD later
+// Distributions are dumped with the 'latency' console command
+class TouchLatency {
+public:
+    // Register the display and input device events and the console command
+    static void init(lv_display_t *disp, lv_indev_t *indev);
+
+    // Only count flushes that overlap obj (e.g. the keyboard a text area tap reveals), nullptr = any
+    static void setWatch(lv_obj_t *obj);
+
+    // Touch driver: a press was just read from the controller (UI task)
+    static void touchSample();
+
+    // Display driver: an area is in the framebuffer (UI task or flush task)
+    static void flushDone(const lv_area_t *area);
+
+    // Median touch-to-photon time in us, 0 until enough presses were measured
+    static uint32_t totalMedianUs();
+
+    static void dump();
+    static void reset();
+
+private:
+    enum State {
+        IDLE,
+        SAMPLED,      // Press read, waiting for the event dispatch
+        DISPATCHED,   // Handlers ran, waiting for the next frame to start
+        RENDERING,    // Frame in progress, waiting for a matching flush
+    };
+
+    static volatile State state;
+    static uint32_t sample_us;
+    static uint32_t dispatch_us;
+    static lv_obj_t *watch_obj;
+    static lv_area_t watch_area;  // Copy taken at dispatch, the flush task must not touch objects
+    static bool watch_any;
+
+    static Histogram input_time;     // sample -> dispatch
+    static Histogram render_time;    // dispatch -> flush
+    static Histogram total_time;     // sample -> flush
+    static uint32_t no_response;     // Presses without a matching flush within TOUCH_LATENCY_TIMEOUT_MS
+
+    static void indev_event_cb(lv_event_t *e);
+    static void display_event_cb(lv_event_t *e);
+    static void watch_delete_cb(lv_event_t *e);
+    static void checkTimeout(uint32_t now);
+    static void consoleLatency(const char *args);
+};
+
+#endif // TOUCH_LATENCY_H
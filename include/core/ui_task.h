@@ -0,0 +1,27 @@
+#ifndef UI_TASK_H
+#define UI_TASK_H
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+// Dedicated LVGL task pinned to UI_TASK_CORE
+// Runs lv_timer_handler() and PowerManager::update() under the LVGL lock, then sleeps without it
+// exactly until the next LVGL timer or PowerManager deadline, or until woken by notify()
+class UiTask {
+public:
+    // Create the task (call once after ui_init)
+    static void start();
+
+    // Wake the UI task immediately (touch, network or any other task that changed the UI)
+    static void notify();
+    static void notifyFromISR();
+
+private:
+    static TaskHandle_t task_handle;
+    static SemaphoreHandle_t wake_sem;
+
+    static void run(void *param);
+    static uint32_t pass();
+};
+
+#endif // UI_TASK_H
@@ -2,15 +2,23 @@
 #define WIFI_DRIVER_H
 
 #include <WiFi.h>
+#include <string>
 
 class WiFiDriver
 {
 private:
     static std::string ssid;
     static std::string passwd;
+
+    static void connect(void);
+    static void consoleWifi(const char *args);
 public:
     WiFiDriver() = delete;
+
+    // Load credentials from preferences and start connecting in the background
+    // Credentials are set with the 'wifi <ssid> <password>' console command
     static void init(void);
+    static bool isConnected(void) { return WiFi.status() == WL_CONNECTED; }
 };
 
 #endif // WIFI_DRIVER_H
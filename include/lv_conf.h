@@ -47,7 +47,11 @@
  * - LV_STDLIB_RTTHREAD:    RT-Thread implementation
  * - LV_STDLIB_CUSTOM:      Implement the functions externally
  */
-#define LV_USE_STDLIB_MALLOC    LV_STDLIB_BUILTIN
+#ifdef HOMEPANEL_NATIVE
+#define LV_USE_STDLIB_MALLOC    LV_STDLIB_BUILTIN  /**< Host build: fixed pool, so lv_mem_monitor() numbers are comparable between runs */
+#else
+#define LV_USE_STDLIB_MALLOC    LV_STDLIB_CUSTOM   /**< SRAM arena for small objects, PSRAM for buffers (src/core/lvgl_heap.cpp) */
+#endif
 
 /** Possible values
  * - LV_STDLIB_BUILTIN:     LVGL's built in implementation
@@ -84,7 +88,7 @@
     /** Set an address for the memory pool instead of allocating it as a normal array. Can be in external SRAM too. */
     #define LV_MEM_ADR 0     /**< 0: unused*/
     /* Instead of an address give a memory allocator that will be called to get a memory pool for LVGL. E.g. my_malloc */
-    #if LV_MEM_ADR == 0
+    #if LV_MEM_ADR == 0 && !defined(HOMEPANEL_NATIVE)
         #define LV_MEM_POOL_INCLUDE <esp_heap_caps.h>
         #define LV_MEM_POOL_ALLOC(size)   heap_caps_malloc(size, MALLOC_CAP_SPIRAM)
     #endif
@@ -114,7 +118,11 @@
  * - LV_OS_MQX
  * - LV_OS_SDL2
  * - LV_OS_CUSTOM */
-#define LV_USE_OS   LV_OS_NONE
+#ifdef HOMEPANEL_NATIVE
+#define LV_USE_OS   LV_OS_NONE      /* Host build: one draw unit, deterministic rendering order */
+#else
+#define LV_USE_OS   LV_OS_FREERTOS  /* Needed for the second draw unit, see LV_DRAW_SW_DRAW_UNIT_CNT */
+#endif
 
 #if LV_USE_OS == LV_OS_CUSTOM
     #define LV_OS_CUSTOM_INCLUDE <stdint.h>
@@ -199,7 +207,11 @@
     /** Set number of draw units.
      *  - > 1 requires operating system to be enabled in `LV_USE_OS`.
      *  - > 1 means multiple threads will render the screen in parallel. */
+    #if LV_USE_OS == LV_OS_NONE
     #define LV_DRAW_SW_DRAW_UNIT_CNT    1
+    #else
+    #define LV_DRAW_SW_DRAW_UNIT_CNT    2   /* One draw thread per ESP32-S3 core */
+    #endif
 
     /** Use Arm-2D to accelerate software (sw) rendering. */
     #define LV_USE_DRAW_ARM2D_SYNC      0
@@ -225,10 +237,14 @@
         #define LV_DRAW_SW_CIRCLE_CACHE_SIZE 4
     #endif
 
-    #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE
+    #ifdef HOMEPANEL_NATIVE
+    #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_NONE    /* Host build: LVGL's C blenders */
+    #else
+    #define  LV_USE_DRAW_SW_ASM     LV_DRAW_SW_ASM_CUSTOM  /* ESP32-S3 PIE kernels */
+    #endif
 
     #if LV_USE_DRAW_SW_ASM == LV_DRAW_SW_ASM_CUSTOM
-        #define  LV_DRAW_SW_ASM_CUSTOM_INCLUDE ""
+        #define  LV_DRAW_SW_ASM_CUSTOM_INCLUDE "core/draw_sw_pie.h"
     #endif
 
     /** Enable drawing complex gradients in software: linear at an angle, radial or conical */
@@ -460,11 +476,11 @@
  *  If size is not set to 0, the decoder will fail to decode when the cache is full.
  *  If size is 0, the cache function is not enabled and the decoded memory will be
  *  released immediately after use. */
-#define LV_CACHE_DEF_SIZE       0
+#define LV_CACHE_DEF_SIZE       (4 * 1024 * 1024)   /* Decoded image budget, allocated in PSRAM (see core/image_cache.cpp) */
 
 /** Default number of image header cache entries. The cache is used to store the headers of images
  *  The main logic is like `LV_CACHE_DEF_SIZE` but for image headers. */
-#define LV_IMAGE_HEADER_CACHE_DEF_CNT 0
+#define LV_IMAGE_HEADER_CACHE_DEF_CNT 32
 
 /** Number of stops allowed per gradient. Increase this to allow more stops.
  *  This adds (sizeof(lv_color_t) + 1) bytes per additional stop. */
@@ -592,17 +608,17 @@
  * https://fonts.google.com/specimen/Montserrat */
 #define LV_FONT_MONTSERRAT_8  0  // Disabled: Not used in UI
 #define LV_FONT_MONTSERRAT_10 0  // Disabled: Not used in UI
-#define LV_FONT_MONTSERRAT_12 1  // Used: Status tab file progress labels
-#define LV_FONT_MONTSERRAT_14 1  // Used: Jog controls, step labels, status labels
-#define LV_FONT_MONTSERRAT_16 1  // Used: Files tab, settings, probe results, dialogs
-#define LV_FONT_MONTSERRAT_18 1  // Used: Tab headers, status bar, common UI, settings
-#define LV_FONT_MONTSERRAT_20 1  // Used: Main tabs, probe buttons, status values, keyboards
-#define LV_FONT_MONTSERRAT_22 1  // Used: Machine select, dialogs, state popups
-#define LV_FONT_MONTSERRAT_24 1  // Used: State popup messages, empty state messages
-#define LV_FONT_MONTSERRAT_26 1  // Used: Machine select connection label
+#define LV_FONT_MONTSERRAT_12 0  // Loaded on demand from LittleFS (FontStore)
+#define LV_FONT_MONTSERRAT_14 1  // Used: LV_FONT_DEFAULT, also the fallback for file fonts
+#define LV_FONT_MONTSERRAT_16 0  // Loaded on demand from LittleFS (FontStore)
+#define LV_FONT_MONTSERRAT_18 0  // Loaded on demand from LittleFS (FontStore)
+#define LV_FONT_MONTSERRAT_20 0  // Loaded on demand from LittleFS (FontStore)
+#define LV_FONT_MONTSERRAT_22 0  // Loaded on demand from LittleFS (FontStore)
+#define LV_FONT_MONTSERRAT_24 0  // Loaded on demand from LittleFS (FontStore)
+#define LV_FONT_MONTSERRAT_26 0  // Loaded on demand from LittleFS (FontStore)
 #define LV_FONT_MONTSERRAT_28 0  // Disabled: Not used in UI
 #define LV_FONT_MONTSERRAT_30 0  // Disabled: Not used in UI
-#define LV_FONT_MONTSERRAT_32 1  // Used: Page titles, state labels, large value displays
+#define LV_FONT_MONTSERRAT_32 0  // Loaded on demand from LittleFS (FontStore)
 #define LV_FONT_MONTSERRAT_34 0  // Disabled: Not used in UI
 #define LV_FONT_MONTSERRAT_36 0  // Disabled: Not used in UI
 #define LV_FONT_MONTSERRAT_38 0
@@ -893,9 +909,13 @@
 #endif
 
 /** API for Arduino LittleFs. */
+#ifdef HOMEPANEL_NATIVE
 #define LV_USE_FS_ARDUINO_ESP_LITTLEFS 0
+#else
+#define LV_USE_FS_ARDUINO_ESP_LITTLEFS 1
+#endif
 #if LV_USE_FS_ARDUINO_ESP_LITTLEFS
-    #define LV_FS_ARDUINO_ESP_LITTLEFS_LETTER '\0'  /**< Set an upper-case driver-identifier letter for this driver (e.g. 'A'). */
+    #define LV_FS_ARDUINO_ESP_LITTLEFS_LETTER 'F'  /**< Set an upper-case driver-identifier letter for this driver (e.g. 'A'). */
     #define LV_FS_ARDUINO_ESP_LITTLEFS_PATH ""      /**< Set the working directory. File/directory paths will be appended to it. */
 #endif
 
@@ -0,0 +1,42 @@
+#ifndef NATIVE_ARDUINO_H
+#define NATIVE_ARDUINO_H
+
+// Host stand-in for the parts of the Arduino core the panel code uses (HOMEPANEL_NATIVE only)
+// millis()/micros() follow the host's monotonic clock, Serial writes to stdout
+
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#define IRAM_ATTR
+
+uint32_t millis();
+uint32_t micros();
+void delay(uint32_t ms);
+
+// Bluetooth is never started on the host
+inline void btStop() {}
+
+class HardwareSerial {
+public:
+    void begin(unsigned long baud) { (void)baud; }
+    void flush() { fflush(stdout); }
+    int available() { return 0; }
+    int read() { return -1; }
+
+    size_t printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+        va_list args;
+        va_start(args, fmt);
+        int n = vprintf(fmt, args);
+        va_end(args);
+        return n > 0 ? n : 0;
+    }
+    size_t print(const char *s) { return fputs(s, stdout) >= 0 ? strlen(s) : 0; }
+    size_t println(const char *s = "") { return print(s) + print("\n"); }
+};
+
+extern HardwareSerial Serial;
+
+#endif // NATIVE_ARDUINO_H
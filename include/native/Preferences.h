@@ -0,0 +1,43 @@
+#ifndef NATIVE_PREFERENCES_H
+#define NATIVE_PREFERENCES_H
+
+// Host stand-in for the ESP32 Preferences (NVS) library, kept in memory for the process lifetime
+// Every key reads back its default until written, like a freshly erased NVS partition
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+class Preferences {
+public:
+    bool begin(const char *name, bool read_only = false);
+    void end() { ns = nullptr; }
+    bool clear();
+    bool remove(const char *key);
+    bool isKey(const char *key);
+
+    bool getBool(const char *key, bool def = false) { return get(key, def); }
+    uint8_t getUChar(const char *key, uint8_t def = 0) { return get(key, def); }
+    uint16_t getUShort(const char *key, uint16_t def = 0) { return get(key, def); }
+    int32_t getInt(const char *key, int32_t def = 0) { return get(key, def); }
+    uint32_t getUInt(const char *key, uint32_t def = 0) { return get(key, def); }
+    uint64_t getULong64(const char *key, uint64_t def = 0) { return get(key, def); }
+
+    size_t putBool(const char *key, bool value) { return put(key, value, 1); }
+    size_t putUChar(const char *key, uint8_t value) { return put(key, value, 1); }
+    size_t putUShort(const char *key, uint16_t value) { return put(key, value, 2); }
+    size_t putInt(const char *key, int32_t value) { return put(key, (uint32_t)value, 4); }
+    size_t putUInt(const char *key, uint32_t value) { return put(key, value, 4); }
+    size_t putULong64(const char *key, uint64_t value) { return put(key, value, 8); }
+
+private:
+    typedef std::map<std::string, uint64_t> Namespace;
+
+    Namespace *ns = nullptr;
+    bool read_only = false;
+
+    uint64_t get(const char *key, uint64_t def);
+    size_t put(const char *key, uint64_t value, size_t size);
+};
+
+#endif // NATIVE_PREFERENCES_H
@@ -0,0 +1,19 @@
+#ifndef NATIVE_WIFI_H
+#define NATIVE_WIFI_H
+
+// Host stand-in for the Arduino WiFi class, the radio is always off
+
+#include <cstdint>
+
+typedef enum { WIFI_OFF = 0, WIFI_STA = 1 } wifi_mode_t;
+
+class WiFiClass {
+public:
+    bool mode(wifi_mode_t m) { return true; }
+    bool disconnect(bool wifi_off = false, bool erase_ap = false) { return true; }
+    bool isConnected() { return false; }
+};
+
+extern WiFiClass WiFi;
+
+#endif // NATIVE_WIFI_H
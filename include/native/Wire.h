@@ -0,0 +1,31 @@
+#ifndef NATIVE_WIRE_H
+#define NATIVE_WIRE_H
+
+// Host stand-in for the Arduino I2C library: every address acknowledges, writes are counted
+// and dropped, reads return nothing
+
+#include <cstddef>
+#include <cstdint>
+
+class TwoWire {
+public:
+    bool begin(int sda = -1, int scl = -1, uint32_t frequency = 0) { return true; }
+    void setClock(uint32_t frequency) {}
+    void setTimeOut(uint16_t timeout_ms) {}
+
+    void beginTransmission(uint8_t address) { transactions++; }
+    size_t write(uint8_t data) { bytes_written++; return 1; }
+    size_t write(const uint8_t *data, size_t len) { bytes_written += len; return len; }
+    uint8_t endTransmission(bool stop = true) { return 0; }
+
+    uint8_t requestFrom(uint8_t address, size_t len, bool stop = true) { transactions++; return 0; }
+    int available() { return 0; }
+    int read() { return -1; }
+
+    uint32_t transactions = 0;
+    uint32_t bytes_written = 0;
+};
+
+extern TwoWire Wire;
+
+#endif // NATIVE_WIRE_H
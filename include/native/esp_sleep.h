@@ -0,0 +1,19 @@
+#ifndef NATIVE_ESP_SLEEP_H
+#define NATIVE_ESP_SLEEP_H
+
+// Host stand-in for esp_sleep.h, deep sleep ends the process
+
+#include <cstdio>
+#include <cstdlib>
+
+typedef enum { ESP_SLEEP_WAKEUP_ALL = 0 } esp_sleep_source_t;
+
+inline int esp_sleep_disable_wakeup_source(esp_sleep_source_t source) { return 0; }
+inline int esp_sleep_enable_touchpad_wakeup() { return 0; }
+
+[[noreturn]] inline void esp_deep_sleep_start() {
+    printf("esp_deep_sleep_start: exiting (native build)\n");
+    exit(0);
+}
+
+#endif // NATIVE_ESP_SLEEP_H
@@ -24,7 +24,14 @@ extern "C" {
 extern lv_obj_t * ui____initial_actions0;
 
 // IMAGES AND IMAGE SETS
+// Device builds set UI_BUILTIN_BACKGROUND=0: the wallpaper comes from the assets
+// partition and the 800x480 image stays out of the app binary
+#ifndef UI_BUILTIN_BACKGROUND
+#define UI_BUILTIN_BACKGROUND 1
+#endif
+#if UI_BUILTIN_BACKGROUND
 LV_IMG_DECLARE(ui_default_img);    // assets/lvgl_test_image.png
+#endif
 
 // UI INIT
 void ui_init(void);
@@ -0,0 +1,95 @@
+#include "core/asset_store.h"
+#include "core/serial_console.h"
+
+// Static member initialization
+const AssetStore::Entry *AssetStore::entries = nullptr;
+lv_image_dsc_t *AssetStore::images = nullptr;
+uint16_t AssetStore::asset_count = 0;
+#if ESP_IDF_VERSION_MAJOR >= 5
+esp_partition_mmap_handle_t AssetStore::mmap_handle = 0;
+#define ASSET_MMAP_DATA ESP_PARTITION_MMAP_DATA
+#define asset_munmap esp_partition_munmap
+#else
+// IDF 4.4 (Arduino-ESP32 2.x): partition mappings are plain spi_flash mappings
+spi_flash_mmap_handle_t AssetStore::mmap_handle = 0;
+#define ASSET_MMAP_DATA SPI_FLASH_MMAP_DATA
+#define asset_munmap spi_flash_munmap
+#endif
+
+bool AssetStore::init() {
+    SerialConsole::registerCommand("assets", "List images in the assets partition", consoleAssets);
+
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                                           (esp_partition_subtype_t)ASSET_PARTITION_SUBTYPE,
+                                                           ASSET_PARTITION_LABEL);
+    if (!part) {
+        Serial.println("AssetStore: No assets partition");
+        return false;
+    }
+
+    Header header;
+    if (esp_partition_read(part, 0, &header, sizeof(header)) != ESP_OK ||
+        memcmp(header.magic, "HPAS", 4) != 0 || header.version != 1) {
+        Serial.println("AssetStore: Assets partition is empty (pio run -t uploadassets)");
+        return false;
+    }
+    if (header.total_size > part->size ||
+        sizeof(Header) + header.count * sizeof(Entry) > header.total_size) {
+        Serial.println("AssetStore: ERROR: Assets partition header is corrupt");
+        return false;
+    }
+
+    // Only map what is used, every page costs an MMU entry shared with PSRAM
+    const void *base;
+    if (esp_partition_mmap(part, 0, header.total_size, ASSET_MMAP_DATA, &base, &mmap_handle) != ESP_OK) {
+        Serial.println("AssetStore: ERROR: Failed to map assets partition");
+        return false;
+    }
+
+    entries = (const Entry *)((const uint8_t *)base + sizeof(Header));
+    images = (lv_image_dsc_t *)calloc(header.count, sizeof(lv_image_dsc_t));
+    if (!images) {
+        asset_munmap(mmap_handle);
+        return false;
+    }
+
+    for (uint16_t i = 0; i < header.count; i++) {
+        const Entry &e = entries[i];
+        lv_image_dsc_t &img = images[i];
+        if (e.offset + e.size > header.total_size) {
+            Serial.printf("AssetStore: Skipping '%.32s', out of bounds\n", e.name);
+            continue;
+        }
+
+        img.header.magic = LV_IMAGE_HEADER_MAGIC;
+        img.header.cf = e.format == FORMAT_RGB565A8 ? LV_COLOR_FORMAT_RGB565A8 : LV_COLOR_FORMAT_RGB565;
+        img.header.w = e.width;
+        img.header.h = e.height;
+        img.header.stride = e.stride;
+        img.data_size = e.size;
+        img.data = (const uint8_t *)base + e.offset;
+    }
+    asset_count = header.count;
+
+    Serial.printf("AssetStore: %d image(s) mapped from '%s' (%lu of %lu KB)\n", asset_count,
+                  ASSET_PARTITION_LABEL, header.total_size / 1024, part->size / 1024);
+    return true;
+}
+
+const lv_image_dsc_t *AssetStore::get(const char *name) {
+    for (uint16_t i = 0; i < asset_count; i++) {
+        if (strncmp(entries[i].name, name, sizeof(entries[i].name)) == 0) {
+            return images[i].data ? &images[i] : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+void AssetStore::consoleAssets(const char *args) {
+    Serial.printf("\n=== Assets: %d image(s) ===\n", asset_count);
+    for (uint16_t i = 0; i < asset_count; i++) {
+        const Entry &e = entries[i];
+        Serial.printf("  %-24.32s %4dx%-4d %-8s %lu bytes\n", e.name, e.width, e.height,
+                      e.format == FORMAT_RGB565A8 ? "RGB565A8" : "RGB565", e.size);
+    }
+}
@@ -0,0 +1,255 @@
+#include "core/benchmark.h"
+#include "core/display_driver.h"
+#include "core/frame_stats.h"
+#include "core/draw_sw_pie.h"
+#include "core/font_store.h"
+#include "core/scenario_bench.h"
+#include "core/lvgl_lock.h"
+#include "config.h"
+#include "ui.h"
+#include <esp_heap_caps.h>
+
+void Benchmark::runAll() {
+    LvglLock lock;
+
+    Serial.println("\n=== Display Benchmarks ===");
+    runSwapBenchmark();
+    runFrameBenchmark();
+    runStripeBenchmark();
+    runKernelBenchmark();
+    runKeyboardBenchmark();
+    runLabelBenchmark();
+    runScenarioBenchmark();
+    Serial.println("=== Benchmarks Complete ===\n");
+}
+
+void Benchmark::runSwapBenchmark() {
+    uint32_t px_count = SCREEN_WIDTH * SCREEN_HEIGHT;
+    uint8_t *buf = (uint8_t *)heap_caps_malloc(px_count * sizeof(uint16_t), MALLOC_CAP_SPIRAM);
+    if (!buf) {
+        Serial.println("Swap benchmark: failed to allocate full-screen buffer in PSRAM");
+        return;
+    }
+    memset(buf, 0x5A, px_count * sizeof(uint16_t));
+
+    uint32_t total_us = 0;
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        uint32_t start = micros();
+        lv_draw_sw_rgb565_swap(buf, px_count);
+        total_us += micros() - start;
+    }
+    heap_caps_free(buf);
+
+    Serial.printf("RGB565 swap (PSRAM, %lu px): %.2f ms per full frame saved by native RGB565_SWAPPED rendering\n",
+                  px_count, total_us / 1000.0f / BENCHMARK_ITERATIONS);
+}
+
+void Benchmark::runFrameBenchmark() {
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp) return;
+
+    // Warm up once so first-draw costs (image header lookups, layout) are not counted
+    timeFullRefresh(disp);
+
+    uint32_t total_us = 0;
+    uint32_t max_us = 0;
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        uint32_t frame_us = timeFullRefresh(disp);
+        total_us += frame_us;
+        if (frame_us > max_us) max_us = frame_us;
+    }
+
+    Serial.printf("Full-screen refresh [%s]: avg %.2f ms, max %.2f ms\n",
+                  DISPLAY_RENDER_MODE == DISPLAY_RENDER_DIRECT ? "direct" : "partial",
+                  total_us / 1000.0f / BENCHMARK_ITERATIONS,
+                  max_us / 1000.0f);
+}
+
+void Benchmark::runStripeBenchmark() {
+#if DISPLAY_RENDER_MODE == DISPLAY_RENDER_PARTIAL
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp) return;
+    DisplayDriver *driver = (DisplayDriver *)lv_display_get_driver_data(disp);
+    uint32_t orig_lines = driver->getBufferLines();
+    bool orig_internal = driver->isBufferInternal();
+
+    static const struct {
+        uint32_t lines;
+        bool internal;
+    } configs[] = {
+        {16, true}, {32, true}, {48, true}, {64, true}, {96, true}, {120, true},
+        {48, false}, {120, false}, {240, false}, {480, false},
+    };
+
+    // Bytes per full frame that must reach the PSRAM framebuffer
+    const uint32_t frame_bytes = SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(uint16_t);
+
+    Serial.println("Stripe buffers (lines, placement, avg frame, copy, PSRAM traffic estimate):");
+    Serial.println("  (traffic is bytes per frame / frame time, not measured on the bus)");
+    for (const auto &cfg : configs) {
+        if (!driver->allocDrawBuffers(cfg.lines, cfg.internal)) {
+            Serial.printf("  %3lu lines %-5s: skipped, allocation failed\n", cfg.lines, cfg.internal ? "SRAM" : "PSRAM");
+            continue;
+        }
+
+        timeFullRefresh(disp);
+
+        uint64_t copy_start_us = FrameStats::getCopyTimeTotalUs();
+        uint32_t total_us = 0;
+        for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+            total_us += timeFullRefresh(disp);
+        }
+        float avg_ms = total_us / 1000.0f / BENCHMARK_ITERATIONS;
+        float copy_ms = (FrameStats::getCopyTimeTotalUs() - copy_start_us) / 1000.0f / BENCHMARK_ITERATIONS;
+
+        // Estimate, not a measurement: the bytes a frame must move over the PSRAM bus divided by the
+        // frame time. SRAM stripes only write the framebuffer; PSRAM buffers are also written by the
+        // renderer and read back by the copy (lower bound, blending reads not counted)
+        uint32_t psram_bytes = cfg.internal ? frame_bytes : frame_bytes * 3;
+        Serial.printf("  %3lu lines %-5s: %6.2f ms, copy %6.2f ms, ~%5.1f MB/s (est.)\n",
+                      cfg.lines, cfg.internal ? "SRAM" : "PSRAM", avg_ms, copy_ms,
+                      psram_bytes / (avg_ms * 1000.0f));
+    }
+
+    // Restore the boot configuration
+    driver->allocDrawBuffers(orig_lines, orig_internal);
+#else
+    Serial.println("Stripe buffers: not used in direct render mode");
+#endif
+}
+
+// Kernel under test and its scalar reference run on identical input, outputs must match
+#define KERNEL_BENCH(name, ref_call, kernel_call)                                         \
+    do {                                                                                  \
+        uint32_t ref_us = 0, kernel_us = 0;                                               \
+        bool match = true;                                                                \
+        for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {                                  \
+            memcpy(ref_buf, src_buf, bytes);                                              \
+            memcpy(dst_buf, src_buf, bytes);                                              \
+            uint32_t start = micros();                                                    \
+            ref_call;                                                                     \
+            ref_us += micros() - start;                                                   \
+            start = micros();                                                             \
+            kernel_call;                                                                  \
+            kernel_us += micros() - start;                                                \
+            if (memcmp(ref_buf, dst_buf, bytes) != 0) match = false;                      \
+        }                                                                                 \
+        Serial.printf("  %-12s scalar %6lu us, kernel %6lu us (x%.2f) %s\n", name,        \
+                      ref_us / BENCHMARK_ITERATIONS, kernel_us / BENCHMARK_ITERATIONS,    \
+                      kernel_us ? (float)ref_us / kernel_us : 0.0f, match ? "OK" : "MISMATCH"); \
+    } while (0)
+
+void Benchmark::runKernelBenchmark() {
+    // One stripe worth of pixels in internal SRAM, offset by one pixel to exercise unaligned heads
+    const uint32_t px = SCREEN_WIDTH * 16;
+    const uint32_t bytes = (px + 1) * sizeof(uint16_t);
+    uint32_t caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT;
+    uint16_t *src_buf = (uint16_t *)heap_caps_aligned_alloc(16, bytes, caps);
+    uint16_t *ref_buf = (uint16_t *)heap_caps_aligned_alloc(16, bytes, caps);
+    uint16_t *dst_buf = (uint16_t *)heap_caps_aligned_alloc(16, bytes, caps);
+    if (!src_buf || !ref_buf || !dst_buf) {
+        Serial.println("Kernel benchmark: failed to allocate buffers");
+        heap_caps_free(src_buf);
+        heap_caps_free(ref_buf);
+        heap_caps_free(dst_buf);
+        return;
+    }
+    for (uint32_t i = 0; i <= px; i++) src_buf[i] = (uint16_t)esp_random();
+
+    Serial.printf("Draw kernels (%lu px per call):\n", px);
+    KERNEL_BENCH("fill", hp_ref_fill16(ref_buf + 1, px, 0x1234),
+                 hp_fill16(dst_buf + 1, px, 0x1234));
+    KERNEL_BENCH("copy", hp_ref_copy16(ref_buf + 1, src_buf + 1, px),
+                 hp_copy16(dst_buf + 1, src_buf + 1, px));
+
+    heap_caps_free(src_buf);
+    heap_caps_free(ref_buf);
+    heap_caps_free(dst_buf);
+}
+
+void Benchmark::runKeyboardBenchmark() {
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp || !ui_Primary_Keyboard) return;
+
+    // Same state as tapping ui_TextArea1
+    _ui_keyboard_set_target(ui_Primary_Keyboard, ui_TextArea1);
+    _ui_state_modify(ui_Primary_Keyboard, LV_STATE_DISABLED, _UI_MODIFY_STATE_REMOVE);
+    _ui_flag_modify(ui_Primary_Keyboard, LV_OBJ_FLAG_HIDDEN, _UI_MODIFY_FLAG_REMOVE);
+    timeFullRefresh(disp);
+
+    uint32_t total_us = 0;
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        total_us += timeFullRefresh(disp);
+    }
+
+    Serial.printf("ui_Screen1 with keyboard (%d draw unit%s): avg %.2f ms per full-screen frame\n",
+                  LV_DRAW_SW_DRAW_UNIT_CNT, LV_DRAW_SW_DRAW_UNIT_CNT > 1 ? "s" : "",
+                  total_us / 1000.0f / BENCHMARK_ITERATIONS);
+
+    // Back to the boot state
+    _ui_flag_modify(ui_Primary_Keyboard, LV_OBJ_FLAG_HIDDEN, _UI_MODIFY_FLAG_ADD);
+    _ui_state_modify(ui_Primary_Keyboard, LV_STATE_DISABLED, _UI_MODIFY_STATE_ADD);
+    lv_refr_now(disp);
+}
+
+void Benchmark::runLabelBenchmark() {
+    lv_display_t *disp = lv_display_get_default();
+    if (!disp) return;
+
+    const lv_font_t *file_font = FontStore::get("montserrat", 14);
+    if (file_font == LV_FONT_DEFAULT) {
+        Serial.println("Label benchmark: montserrat_14.bin not on LittleFS, run tools/make_fonts.sh and uploadfs");
+        return;
+    }
+
+    // 8 x 16 grid of short labels, about the text density of a settings or status page
+    lv_obj_t *prev_screen = lv_screen_active();
+    lv_obj_t *screen = lv_obj_create(NULL);
+    lv_obj_set_flex_flow(screen, LV_FLEX_FLOW_ROW_WRAP);
+    for (int i = 0; i < 8 * 16; i++) {
+        lv_obj_t *label = lv_label_create(screen);
+        lv_label_set_text_fmt(label, "Value %03d: %d.%02d V", i, i % 24, (i * 37) % 100);
+        lv_obj_set_width(label, SCREEN_WIDTH / 8 - 8);
+    }
+    lv_screen_load(screen);
+
+    // Built-in font: the reference the file font has to match once its glyphs are cached
+    lv_obj_set_style_text_font(screen, LV_FONT_DEFAULT, 0);
+    timeFullRefresh(disp);
+    uint32_t builtin_us = 0;
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        builtin_us += timeFullRefresh(disp);
+    }
+
+    lv_obj_set_style_text_font(screen, file_font, 0);
+    FontStore::dropGlyphs();
+    uint32_t misses = FontStore::getMisses();
+    uint32_t cold_us = timeFullRefresh(disp);
+    misses = FontStore::getMisses() - misses;
+
+    uint32_t warm_us = 0;
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        warm_us += timeFullRefresh(disp);
+    }
+
+    Serial.printf("Label screen (%d labels): built-in %.2f ms, file font cold %.2f ms (%lu glyphs), warm %.2f ms\n",
+                  8 * 16, builtin_us / 1000.0f / BENCHMARK_ITERATIONS, cold_us / 1000.0f, misses,
+                  warm_us / 1000.0f / BENCHMARK_ITERATIONS);
+
+    lv_screen_load(prev_screen);
+    lv_obj_delete(screen);
+    lv_refr_now(disp);
+}
+
+void Benchmark::runScenarioBenchmark() {
+    if (!ScenarioBench::runAll()) {
+        Serial.println("WARNING: UI scenarios over budget, this build renders slower than the last known good one");
+    }
+}
+
+uint32_t Benchmark::timeFullRefresh(lv_display_t* disp) {
+    lv_obj_invalidate(lv_display_get_screen_active(disp));
+    uint32_t start = micros();
+    lv_refr_now(disp);
+    return micros() - start;
+}
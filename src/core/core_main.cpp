@@ -1,7 +1,7 @@
 #include "core/core_main.h"
 
 // This initializes the hardware components
-// Display, Touch, Powermanager, (soon to add SD card if initialization is needed)
+// Display, Touch, Powermanager, WiFi, (soon to add SD card if initialization is needed)
 int core_init()
 {
     // Initialize Display Driver
@@ -13,6 +13,24 @@ int core_init()
     }
     Serial.println("Display driver initialized successfully");
 
+    // lv_malloc() tiers, set up by lv_init() in the display driver
+    LvglHeap::init();
+
+    // Decoded image cache in PSRAM
+    ImageCache::init();
+
+    // Fonts loaded from LittleFS on first use
+    FontStore::init();
+
+    // Pre-converted images drawn straight from flash
+    AssetStore::init();
+
+    // Frequency scaling and light sleep, before the tasks that take PM locks
+    DynamicPower::init();
+
+    // I2C bus task, owns the touch port (GT911, STC8H1K28) from here on
+    I2cBus::start(displayDriver.getLCD()->_touch_instance.config().i2c_port);
+
     // Initialize Touch Driver
     Serial.println("Initializing touch driver...");
     static TouchDriver touchDriver;
@@ -22,10 +40,23 @@ int core_init()
     }
     Serial.println("Touch driver initialized successfully");
 
+    // Touch-to-photon latency probes on the touch and flush paths
+    TouchLatency::init(displayDriver.getDisplay(), touchDriver.getInputDevice());
+
     // Initialize Power Manager
     Serial.println("Initializing power manager...");
     PowerManager::init(&displayDriver);
     Serial.println("Power manager initialized successfully");
 
+    // Initialize networking
+    Serial.println("Initializing WiFi...");
+    WiFiDriver::init();
+#if SCREENSHOT_SERVER_ENABLED
+    ScreenshotServer::init(&displayDriver);
+#endif
+#if MIRROR_ENABLED
+    MirrorServer::init(&displayDriver);
+#endif
+
     return 0;
 }
\ No newline at end of file
@@ -1,10 +1,35 @@
 // This file has been copied and modified from https://github.com/jeyeager65/FluidTouch
 
 #include "core/display_driver.h"
+#include "core/frame_stats.h"
+#include "core/touch_latency.h"
+#include "core/i2c_bus.h"
+#include "core/dynamic_power.h"
 #include <esp_heap_caps.h>
+#include <esp32s3/rom/cache.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/semphr.h>
+#include <esp_timer.h>
 #include <Wire.h>
+#include <driver/ledc.h>
 
 #define MAX_BRIGHTNESS 25
+#define BACKLIGHT_CHANNEL 1  // Basic: LEDC channel driving GPIO2
+
+#if DISPLAY_RENDER_MODE == DISPLAY_RENDER_PARTIAL
+// Async flush: the copy of a rendered area into the panel framebuffer runs on its own task,
+// so LVGL renders the next area into the other draw buffer while the copy is in flight
+struct FlushJob {
+    lv_display_t *disp;
+    lv_area_t area;
+    uint8_t *px_map;
+};
+
+static QueueHandle_t flush_queue = nullptr;
+static SemaphoreHandle_t flush_done = nullptr;
+static volatile bool flush_pending = false;
+#endif
 
 // LovyanGFX constructor
 LGFX::LGFX(void) {
@@ -154,8 +179,12 @@ LGFX::LGFX(void) {
     }
 }
 
+// Static member initialization
+DisplayDriver::FlushObserver DisplayDriver::flush_observer = nullptr;
+
 // DisplayDriver constructor
-DisplayDriver::DisplayDriver() : disp(nullptr), disp_draw_buf(nullptr), disp_draw_buf2(nullptr) {
+DisplayDriver::DisplayDriver() : disp(nullptr), disp_draw_buf(nullptr), disp_draw_buf2(nullptr),
+                                 buffer_lines(0), buffer_internal(false) {
 }
 
 // Initialize display
@@ -167,9 +196,10 @@ bool DisplayDriver::init() {
 #ifdef BACKLIGHT_PWM
     // Basic: PWM backlight - configure but keep OFF until screen is cleared
     pinMode(2, OUTPUT);
-    ledcSetup(1, 300, 8);
-    ledcAttachPin(2, 1);
-    ledcWrite(1, 0);  // Start with backlight OFF
+    ledcSetup(BACKLIGHT_CHANNEL, 300, 8);
+    ledcAttachPin(2, BACKLIGHT_CHANNEL);
+    ledcWrite(BACKLIGHT_CHANNEL, 0);  // Start with backlight OFF
+    ledc_fade_func_install(0);        // Hardware fades for fadeBacklight()
     Serial.println("Backlight configured (OFF)");
     
 #elif defined(BACKLIGHT_I2C)
@@ -197,7 +227,7 @@ bool DisplayDriver::init() {
     delay(50);
     
     // Now turn on backlight after screen is cleared
-    ledcWrite(1, 255);
+    ledcWrite(BACKLIGHT_CHANNEL, 255);
     Serial.println("Backlight ON (PWM)");
 #endif
     
@@ -266,65 +296,315 @@ bool DisplayDriver::init() {
     Serial.println("Backlight initialization complete");
 #endif
     
-    // Initialize LVGL
+    // Initialize LVGL, ticks come straight from esp_timer
     lv_init();
+    lv_tick_set_cb(lv_tick_cb);
     
-    // Allocate display buffers in PSRAM (dual buffering for smooth rendering)
-    uint32_t buf_size = SCREEN_WIDTH * BUFFER_LINES;
-    disp_draw_buf = (lv_color_t *)heap_caps_malloc(buf_size * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
-    disp_draw_buf2 = (lv_color_t *)heap_caps_malloc(buf_size * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
+    // Create LVGL display
+    disp = lv_display_create(SCREEN_WIDTH, SCREEN_HEIGHT);
+    lv_display_set_flush_cb(disp, my_disp_flush);
     
-    if (!disp_draw_buf || !disp_draw_buf2) {
-        Serial.println("ERROR: Failed to allocate display buffers in PSRAM!");
+#if DISPLAY_RENDER_MODE == DISPLAY_RENDER_DIRECT
+    // Render straight into the Panel_RGB framebuffer (no draw buffers, no copy on flush)
+    // The framebuffer holds byte-swapped RGB565, which is what Bus_RGB scans out
+    uint16_t *frame_buffer = lcd._panel_instance.getFrameBuffer();
+    if (!frame_buffer) {
+        Serial.println("ERROR: Panel framebuffer not available for direct rendering!");
         return false;
     }
     
-    Serial.printf("Display buffers allocated in PSRAM: 2 x %lu bytes\n", buf_size * sizeof(lv_color_t));
+    uint32_t fb_size = SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(uint16_t);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565_SWAPPED);
+    lv_display_set_buffers(disp, frame_buffer, NULL, fb_size, LV_DISPLAY_RENDER_MODE_DIRECT);
     
-    // Create LVGL display
-    disp = lv_display_create(SCREEN_WIDTH, SCREEN_HEIGHT);
-    lv_display_set_flush_cb(disp, my_disp_flush);
-    lv_display_set_buffers(disp, disp_draw_buf, disp_draw_buf2, buf_size * sizeof(lv_color_t), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    Serial.printf("Display render mode: DIRECT into panel framebuffer (%lu bytes)\n", fb_size);
+#else
+    // Render in the panel's byte order so flushed areas can be copied without a swap pass
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565_SWAPPED);
+    
+#if DISPLAY_BUFFER_STRATEGY == DISPLAY_BUFFER_SRAM
+    // Stripe buffers in internal SRAM, fall back to PSRAM if internal memory is too tight
+    uint32_t stripe_lines = STRIPE_LINES > 0 ? STRIPE_LINES : autoStripeLines();
+    if (!allocDrawBuffers(stripe_lines, true)) {
+        Serial.println("WARNING: Internal SRAM stripe buffers unavailable, falling back to PSRAM");
+        if (!allocDrawBuffers(BUFFER_LINES, false)) return false;
+    }
+#else
+    // Allocate display buffers in PSRAM (dual buffering for smooth rendering)
+    if (!allocDrawBuffers(BUFFER_LINES, false)) return false;
+#endif
+    
+    // Flush task copies areas into the framebuffer and signals LVGL when each copy completes
+    flush_queue = xQueueCreate(1, sizeof(FlushJob));
+    flush_done = xSemaphoreCreateBinary();
+    if (!flush_queue || !flush_done ||
+        xTaskCreatePinnedToCore(flush_task, "lv_flush", 4096, NULL,
+                                DISPLAY_FLUSH_TASK_PRIO, NULL, DISPLAY_FLUSH_TASK_CORE) != pdPASS) {
+        Serial.println("ERROR: Failed to create display flush task!");
+        return false;
+    }
+    lv_display_set_flush_wait_cb(disp, my_flush_wait);
+    
+    Serial.println("Display render mode: PARTIAL with async copy to panel framebuffer");
+#endif
     
     // Store lcd instance in display user data for flush callback
     lv_display_set_user_data(disp, &lcd);
+    lv_display_set_driver_data(disp, this);
+    
+    // Frame render/flush instrumentation
+    FrameStats::init(disp);
     
     return true;
 }
 
+// LVGL tick source (milliseconds since boot)
+uint32_t DisplayDriver::lv_tick_cb() {
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+// Allocate both draw buffers and hand them to LVGL
+bool DisplayDriver::allocDrawBuffers(uint32_t lines, bool internal) {
+#if DISPLAY_RENDER_MODE == DISPLAY_RENDER_PARTIAL
+    if (lines == 0) return false;
+    
+    // New buffers first, on failure LVGL keeps rendering into the old ones
+    uint32_t caps = internal ? (MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA) : MALLOC_CAP_SPIRAM;
+    uint32_t buf_bytes = SCREEN_WIDTH * lines * DRAW_BUF_PX_SIZE;
+    lv_color_t *buf1 = (lv_color_t *)heap_caps_malloc(buf_bytes, caps);
+    lv_color_t *buf2 = (lv_color_t *)heap_caps_malloc(buf_bytes, caps);
+    
+    if (!buf1 || !buf2) {
+        Serial.printf("ERROR: Failed to allocate display buffers in %s!\n", internal ? "internal SRAM" : "PSRAM");
+        if (buf1) heap_caps_free(buf1);
+        if (buf2) heap_caps_free(buf2);
+        return false;
+    }
+    
+    // Never swap out a buffer the flush task is still copying from
+    while (flush_pending) vTaskDelay(1);
+    lv_display_set_buffers(disp, buf1, buf2, buf_bytes, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    
+    if (disp_draw_buf) heap_caps_free(disp_draw_buf);
+    if (disp_draw_buf2) heap_caps_free(disp_draw_buf2);
+    disp_draw_buf = buf1;
+    disp_draw_buf2 = buf2;
+    buffer_lines = lines;
+    buffer_internal = internal;
+    
+    Serial.printf("Display buffers allocated in %s: 2 x %lu bytes (%lu lines), free internal heap: %u bytes\n",
+                  internal ? "internal SRAM" : "PSRAM", buf_bytes, lines,
+                  heap_caps_get_free_size(MALLOC_CAP_INTERNAL));
+    return true;
+#else
+    // Direct mode renders into the panel framebuffer, there are no draw buffers
+    return false;
+#endif
+}
+
+uint32_t DisplayDriver::autoStripeLines() {
+    uint32_t caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA;
+    uint32_t free_bytes = heap_caps_get_free_size(caps);
+    uint32_t largest = heap_caps_get_largest_free_block(caps);
+    
+    // Two buffers out of what is left after the Wi-Fi reserve, each must fit in one free block
+    uint32_t budget = free_bytes > WIFI_HEAP_RESERVE ? (free_bytes - WIFI_HEAP_RESERVE) / 2 : 0;
+    if (budget > largest) budget = largest;
+    
+    uint32_t lines = budget / (SCREEN_WIDTH * DRAW_BUF_PX_SIZE);
+    if (lines > STRIPE_LINES_MAX) lines = STRIPE_LINES_MAX;
+    if (lines < STRIPE_LINES_MIN) {
+        // Not even the minimum fits beside the reserve, 0 makes init fall back to PSRAM
+        Serial.printf("Stripe auto sizing: %u bytes free internal (largest block %u), below %u lines\n",
+                      free_bytes, largest, STRIPE_LINES_MIN);
+        return 0;
+    }
+    
+    Serial.printf("Stripe auto sizing: %u bytes free internal (largest block %u), using %lu lines\n",
+                  free_bytes, largest, lines);
+    return lines;
+}
+
 // LVGL flush callback
 void DisplayDriver::my_disp_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
-    LGFX *lcd = (LGFX *)lv_display_get_user_data(disp);
+    FrameStats::flushBegin(area);
     
-    uint32_t w = lv_area_get_width(area);
-    uint32_t h = lv_area_get_height(area);
+#if DISPLAY_RENDER_MODE == DISPLAY_RENDER_DIRECT
+    if (flush_observer) {
+        flush_observer(area, (uint16_t *)px_map + area->y1 * SCREEN_WIDTH + area->x1, SCREEN_WIDTH);
+    }
     
-    lv_draw_sw_rgb565_swap(px_map, w * h);
-    lcd->pushImageDMA(area->x1, area->y1, w, h, (uint16_t *)px_map);
+    // px_map is the framebuffer itself - just write the dirty lines back from cache to PSRAM
+    // so the RGB DMA scans out what LVGL rendered
+    uint16_t *fb = (uint16_t *)px_map;
+    uint32_t start = (uint32_t)(fb + area->y1 * SCREEN_WIDTH);
+    uint32_t size = lv_area_get_height(area) * SCREEN_WIDTH * sizeof(uint16_t);
+    uint32_t wb_start = micros();
+    Cache_WriteBack_Addr(start, size);
+    FrameStats::addCopyTime(micros() - wb_start);
+    TouchLatency::flushDone(area);
     
     lv_display_flush_ready(disp);
+#else
+    if (flush_observer) {
+        flush_observer(area, (uint16_t *)px_map, lv_area_get_width(area));
+    }
+    
+    // Hand the area to the flush task, lv_display_flush_ready() is called once the copy is done
+    FlushJob job = { disp, *area, px_map };
+    flush_pending = true;
+    DynamicPower::flushBegin();
+    xQueueSend(flush_queue, &job, portMAX_DELAY);
+#endif
+    
+    FrameStats::flushEnd();
 }
 
+#if DISPLAY_RENDER_MODE == DISPLAY_RENDER_PARTIAL
+// Copies flushed areas into the panel framebuffer
+void DisplayDriver::flush_task(void *param) {
+    FlushJob job;
+    while (true) {
+        if (xQueueReceive(flush_queue, &job, portMAX_DELAY) != pdTRUE) continue;
+        
+        LGFX *lcd = (LGFX *)lv_display_get_user_data(job.disp);
+        uint32_t w = lv_area_get_width(&job.area);
+        uint32_t h = lv_area_get_height(&job.area);
+        
+        // px_map is already RGB565_SWAPPED (LovyanGFX's native 16-bit order)
+        uint32_t start = micros();
+        lcd->pushImageDMA(job.area.x1, job.area.y1, w, h, (uint16_t *)job.px_map);
+        FrameStats::addCopyTime(micros() - start);
+        TouchLatency::flushDone(&job.area);
+        
+        flush_pending = false;
+        DynamicPower::flushEnd();
+        lv_display_flush_ready(job.disp);
+        xSemaphoreGive(flush_done);
+    }
+}
+
+// Called by LVGL before it reuses a draw buffer that may still be in flight
+void DisplayDriver::my_flush_wait(lv_display_t *disp) {
+    FrameStats::waitBegin();
+    
+    // A stale give from an already finished copy just makes us re-check the flag
+    while (flush_pending) {
+        xSemaphoreTake(flush_done, portMAX_DELAY);
+    }
+    
+    FrameStats::waitEnd();
+}
+#endif
+
 // Backlight control methods
-void DisplayDriver::setBacklight(uint8_t brightness_percent) {
+// Brightness 0-255 as the backlight shows it, the end point of a fade in progress
+static uint8_t backlight_level = 0;
+
+static uint8_t percentToLevel(uint8_t brightness_percent) {
     // Clamp to valid percentage range
     if (brightness_percent > MAX_BRIGHTNESS) brightness_percent = MAX_BRIGHTNESS;
     
     // Convert percentage (0-100) to hardware value (0-255)
-    uint8_t hw_value = (brightness_percent * 255) / 100;
-    
+    return (brightness_percent * 255) / 100;
+}
+
+#ifdef BACKLIGHT_I2C
+// Advance: stepped ramp through the STC8H1K28, each esp_timer tick posts the next level to
+// the I2C bus task (coalesced, so a slow bus skips steps rather than falling behind)
+static esp_timer_handle_t fade_timer = nullptr;
+static portMUX_TYPE fade_mux = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint32_t fade_gen = 0;      // Bumped by every cancel or restart of the ramp
+static volatile uint8_t shown_level = 0;    // Level last posted, where a new ramp starts
+static struct {
+    uint8_t from;
+    uint8_t to;
+    uint32_t start_us;
+    uint32_t duration_us;
+} ramp;
+
+// Brightness: 0 = brightest, 245 = off
+static inline uint8_t levelToI2c(uint8_t level) {
+    return 245 - ((level * 245) / 255);
+}
+
+static void fade_step(void *arg) {
+    portENTER_CRITICAL(&fade_mux);
+    uint32_t gen = fade_gen;
+    uint32_t elapsed = (uint32_t)esp_timer_get_time() - ramp.start_us;
+    bool done = elapsed >= ramp.duration_us;
+    int32_t level = done ? ramp.to
+                         : ramp.from + ((int32_t)ramp.to - ramp.from) * (int32_t)(elapsed / 1000) / (int32_t)(ramp.duration_us / 1000);
+    shown_level = level;
+    portEXIT_CRITICAL(&fade_mux);
+    
+    I2cBus::post(I2cBus::SLOT_BACKLIGHT, STC8_ADDR, levelToI2c(level), STC8_I2C_FREQ);
+    if (done) esp_timer_stop(fade_timer);
+    
+    // Cancelled while this step was posting: make sure the step does not outlive the cancel
+    if (gen != fade_gen) {
+        I2cBus::post(I2cBus::SLOT_BACKLIGHT, STC8_ADDR, levelToI2c(shown_level), STC8_I2C_FREQ);
+    }
+}
+#endif
+
+// Stop a fade where it is, the caller sets the level next
+static void cancelFade() {
+#ifdef BACKLIGHT_PWM
+    ledc_fade_stop(LEDC_LOW_SPEED_MODE, (ledc_channel_t)BACKLIGHT_CHANNEL);
+#elif defined(BACKLIGHT_I2C)
+    if (fade_timer) esp_timer_stop(fade_timer);
+    fade_gen++;
+#endif
+}
+
+static void writeLevel(uint8_t level) {
+    backlight_level = level;
 #ifdef BACKLIGHT_PWM
     // Basic: PWM backlight on GPIO2
-    ledcWrite(1, hw_value);
+    ledcWrite(BACKLIGHT_CHANNEL, level);
 #elif defined(BACKLIGHT_I2C)
-    // Advance: I2C backlight controller (STC8H1K28 at address 0x30)
-    // Brightness: 0 = brightest, 245 = off
-    uint8_t i2c_value = 245 - ((hw_value * 245) / 255);
-    Wire.beginTransmission(0x30);
-    Wire.write(i2c_value);
-    Wire.endTransmission();
+    // Advance: I2C backlight controller (STC8H1K28 at address 0x30), sent by the I2C bus task
+    shown_level = level;
+    I2cBus::post(I2cBus::SLOT_BACKLIGHT, STC8_ADDR, levelToI2c(level), STC8_I2C_FREQ);
 #endif
-    Serial.printf("Backlight set to: %d%% (hw=%d)\n", brightness_percent, hw_value);
+}
+
+// Instant, also cancels a fade in progress
+void DisplayDriver::setBacklight(uint8_t brightness_percent) {
+    cancelFade();
+    writeLevel(percentToLevel(brightness_percent));
+}
+
+void DisplayDriver::fadeBacklight(uint8_t brightness_percent, uint32_t duration_ms) {
+    uint8_t target = percentToLevel(brightness_percent);
+    if (duration_ms == 0 || target == backlight_level) {
+        setBacklight(brightness_percent);
+        return;
+    }
+    
+#ifdef BACKLIGHT_PWM
+    // The LEDC fade engine ramps the duty in hardware, nothing runs until it is done
+    ledc_fade_stop(LEDC_LOW_SPEED_MODE, (ledc_channel_t)BACKLIGHT_CHANNEL);
+    ledc_set_fade_with_time(LEDC_LOW_SPEED_MODE, (ledc_channel_t)BACKLIGHT_CHANNEL, target, duration_ms);
+    ledc_fade_start(LEDC_LOW_SPEED_MODE, (ledc_channel_t)BACKLIGHT_CHANNEL, LEDC_FADE_NO_WAIT);
+#elif defined(BACKLIGHT_I2C)
+    if (!fade_timer) {
+        esp_timer_create_args_t args = {};
+        args.callback = fade_step;
+        args.name = "bl_fade";
+        esp_timer_create(&args, &fade_timer);
+    }
+    cancelFade();
+    portENTER_CRITICAL(&fade_mux);
+    ramp.from = shown_level;
+    ramp.to = target;
+    ramp.start_us = (uint32_t)esp_timer_get_time();
+    ramp.duration_us = duration_ms * 1000;
+    portEXIT_CRITICAL(&fade_mux);
+    esp_timer_start_periodic(fade_timer, BACKLIGHT_FADE_STEP_MS * 1000);
+#endif
+    backlight_level = target;
 }
 
 void DisplayDriver::setBacklightOn() {
@@ -332,17 +612,22 @@ void DisplayDriver::setBacklightOn() {
 }
 
 void DisplayDriver::setBacklightOff() {
+    cancelFade();
+    backlight_level = 0;
 #ifdef BACKLIGHT_PWM
     // Basic: PWM backlight on GPIO2
-    ledcWrite(1, 0);
-    Serial.println("Backlight OFF (PWM)");
+    ledcWrite(BACKLIGHT_CHANNEL, 0);
 #elif defined(BACKLIGHT_I2C)
     // Advance: I2C backlight controller (STC8H1K28 at address 0x30)
     // Send 0xF5 (245) for off
-    Wire.beginTransmission(0x30);
-    Wire.write(0xF5);
-    Wire.endTransmission();
-    Serial.println("Backlight OFF (I2C)");
+    shown_level = 0;
+    I2cBus::post(I2cBus::SLOT_BACKLIGHT, STC8_ADDR, 0xF5, STC8_I2C_FREQ);
+#endif
+}
+
+void DisplayDriver::waitForFlush() {
+#if DISPLAY_RENDER_MODE == DISPLAY_RENDER_PARTIAL
+    while (flush_pending) vTaskDelay(1);
 #endif
 }
 
@@ -355,6 +640,7 @@ void DisplayDriver::powerDown() {
     // Leaving GT911 in normal mode allows it to wake naturally when ESP32 wakes.
     // (Advance hardware works either way because STC8H1K28 handles GT911 reset independently)
     setBacklightOff();
+    I2cBus::flush(100);  // The write is queued, get it out before the chip sleeps
     
     Serial.println("  Display powered down (backlight off only)");
 }
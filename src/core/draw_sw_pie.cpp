@@ -0,0 +1,106 @@
+#include "core/draw_sw_pie.h"
+#include <lvgl_private.h>
+#include <string.h>
+
+#if defined(ESP_PLATFORM)
+#include "sdkconfig.h"
+#endif
+
+#if defined(CONFIG_IDF_TARGET_ESP32S3) && !defined(HP_DISABLE_PIE)
+// PIE inner loops (draw_sw_pie_s3.S), 16-byte aligned pointers, blocks of 16 bytes (8 pixels)
+extern "C" void hp_pie_fill_128(uint16_t *dst, uint32_t color2, uint32_t blocks);
+extern "C" void hp_pie_copy_128(uint16_t *dst, const uint16_t *src, uint32_t blocks);
+#define HP_USE_PIE 1
+#else
+#define HP_USE_PIE 0
+#endif
+
+static inline uint16_t swap16(uint16_t c) {
+    return (uint16_t)((c >> 8) | (c << 8));
+}
+
+/**********************
+ * Scalar references
+ **********************/
+
+void hp_ref_fill16(uint16_t *dst, uint32_t px_cnt, uint16_t color) {
+    for (uint32_t i = 0; i < px_cnt; i++) dst[i] = color;
+}
+
+void hp_ref_copy16(uint16_t *dst, const uint16_t *src, uint32_t px_cnt) {
+    for (uint32_t i = 0; i < px_cnt; i++) dst[i] = src[i];
+}
+
+/**********************
+ * Kernels
+ **********************/
+
+void hp_fill16(uint16_t *dst, uint32_t px_cnt, uint16_t color) {
+#if HP_USE_PIE
+    // Scalar head up to a 16-byte boundary, vector body, scalar tail
+    while (px_cnt && ((uintptr_t)dst & 15)) {
+        *dst++ = color;
+        px_cnt--;
+    }
+    uint32_t blocks = px_cnt / 8;
+    if (blocks) {
+        hp_pie_fill_128(dst, (uint32_t)color | ((uint32_t)color << 16), blocks);
+        dst += blocks * 8;
+        px_cnt -= blocks * 8;
+    }
+#endif
+    while (px_cnt--) *dst++ = color;
+}
+
+void hp_copy16(uint16_t *dst, const uint16_t *src, uint32_t px_cnt) {
+#if HP_USE_PIE
+    // The vector path needs both pointers on the same 16-byte phase
+    if (px_cnt >= 16 && (((uintptr_t)dst ^ (uintptr_t)src) & 15) == 0) {
+        while ((uintptr_t)dst & 15) {
+            *dst++ = *src++;
+            px_cnt--;
+        }
+        uint32_t blocks = px_cnt / 8;
+        hp_pie_copy_128(dst, src, blocks);
+        dst += blocks * 8;
+        src += blocks * 8;
+        px_cnt -= blocks * 8;
+        while (px_cnt--) *dst++ = *src++;
+        return;
+    }
+#endif
+    memcpy(dst, src, px_cnt * sizeof(uint16_t));
+}
+
+/**********************
+ * LVGL hooks
+ **********************/
+
+lv_result_t hp_blend_color_to_rgb565(lv_draw_sw_blend_fill_dsc_t *dsc, bool swapped) {
+    uint16_t color = lv_color_to_u16(dsc->color);
+    if (swapped) color = swap16(color);
+
+    uint8_t *row = (uint8_t *)dsc->dest_buf;
+    for (int32_t y = 0; y < dsc->dest_h; y++) {
+        hp_fill16((uint16_t *)row, dsc->dest_w, color);
+        row += dsc->dest_stride;
+    }
+    return LV_RESULT_OK;
+}
+
+lv_result_t hp_blend_rgb565_to_rgb565(lv_draw_sw_blend_image_dsc_t *dsc, bool src_swapped, bool dest_swapped) {
+    // Only plain opaque copies in the same byte order, everything else stays with LVGL
+    if (dsc->mask_buf != NULL || dsc->opa < LV_OPA_MAX || dsc->blend_mode != LV_BLEND_MODE_NORMAL ||
+        src_swapped != dest_swapped) {
+        return LV_RESULT_INVALID;
+    }
+
+    uint8_t *dest_row = (uint8_t *)dsc->dest_buf;
+    const uint8_t *src_row = (const uint8_t *)dsc->src_buf;
+    for (int32_t y = 0; y < dsc->dest_h; y++) {
+        hp_copy16((uint16_t *)dest_row, (const uint16_t *)src_row, dsc->dest_w);
+        dest_row += dsc->dest_stride;
+        src_row += dsc->src_stride;
+    }
+    return LV_RESULT_OK;
+}
@@ -0,0 +1,210 @@
+#include "core/dynamic_power.h"
+#include "core/serial_console.h"
+#include <esp_timer.h>
+#include <esp_sleep.h>
+#include <esp_idf_version.h>
+#include <driver/gpio.h>
+
+// Static member initialization
+esp_pm_lock_handle_t DynamicPower::render_lock = nullptr;
+esp_pm_lock_handle_t DynamicPower::flush_lock = nullptr;
+esp_pm_lock_handle_t DynamicPower::touch_lock = nullptr;
+esp_pm_lock_handle_t DynamicPower::display_lock = nullptr;
+bool DynamicPower::configured = false;
+bool DynamicPower::light_sleep = false;
+bool DynamicPower::touch_active = false;
+bool DynamicPower::display_on = true;
+volatile bool DynamicPower::touch_wake_armed = false;
+uint32_t DynamicPower::max_holders = 0;
+uint64_t DynamicPower::residency_us[DynamicPower::MODE_COUNT] = {};
+uint64_t DynamicPower::since_us = 0;
+
+// Locks are taken by the UI, flush and I2C tasks
+static portMUX_TYPE residency_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static const char *const mode_names[] = { "max", "min (lit)", "min/sleep (off)" };
+
+void DynamicPower::init() {
+    since_us = esp_timer_get_time();
+    SerialConsole::registerCommand("pm", "CPU frequency residency and PM locks: pm [reset]", consolePm);
+
+#if PM_ENABLED && CONFIG_PM_ENABLE
+#if ESP_IDF_VERSION_MAJOR >= 5
+    esp_pm_config_t cfg = {};
+#else
+    esp_pm_config_esp32s3_t cfg = {};
+#endif
+    cfg.max_freq_mhz = getCpuFrequencyMhz();
+    cfg.min_freq_mhz = PM_MIN_CPU_FREQ_MHZ;
+    cfg.light_sleep_enable = PM_LIGHT_SLEEP;
+
+    esp_err_t err = esp_pm_configure(&cfg);
+    if (err == ESP_ERR_NOT_SUPPORTED && cfg.light_sleep_enable) {
+        // Framework built without tickless idle: frequency scaling only
+        cfg.light_sleep_enable = false;
+        err = esp_pm_configure(&cfg);
+    }
+    if (err != ESP_OK) {
+        Serial.printf("DynamicPower: esp_pm_configure failed (%s), fixed %lu MHz\n", esp_err_to_name(err), getCpuFrequencyMhz());
+        return;
+    }
+    configured = true;
+    light_sleep = cfg.light_sleep_enable;
+
+    esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "render", &render_lock);
+    esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "flush", &flush_lock);
+    esp_pm_lock_create(ESP_PM_CPU_FREQ_MAX, 0, "touch", &touch_lock);
+    esp_pm_lock_create(ESP_PM_NO_LIGHT_SLEEP, 0, "display", &display_lock);
+    if (display_lock) esp_pm_lock_acquire(display_lock);
+
+#if TOUCH_INT >= 0
+    // A touch on the dark panel wakes the chip from light sleep right away, the pin itself is
+    // only armed while the screen is off (armTouchWake)
+    if (light_sleep) esp_sleep_enable_gpio_wakeup();
+#endif
+
+    Serial.printf("DynamicPower: %d-%d MHz, light sleep %s\n", cfg.min_freq_mhz, cfg.max_freq_mhz,
+                  light_sleep ? "when the screen is off" : "unavailable");
+#else
+    Serial.printf("DynamicPower: disabled, fixed %lu MHz\n", getCpuFrequencyMhz());
+#endif
+}
+
+DynamicPower::Mode DynamicPower::currentMode() {
+    if (max_holders > 0 || !configured) return MODE_MAX;
+    return display_on ? MODE_MIN : MODE_SLEEP;
+}
+
+// Close the interval of the mode in effect until now (residency_mux held)
+void DynamicPower::account() {
+    uint64_t now = esp_timer_get_time();
+    residency_us[currentMode()] += now - since_us;
+    since_us = now;
+}
+
+void DynamicPower::acquireMax(esp_pm_lock_handle_t lock) {
+    if (lock) esp_pm_lock_acquire(lock);
+    portENTER_CRITICAL(&residency_mux);
+    if (max_holders == 0) account();
+    max_holders++;
+    portEXIT_CRITICAL(&residency_mux);
+}
+
+void DynamicPower::releaseMax(esp_pm_lock_handle_t lock) {
+    portENTER_CRITICAL(&residency_mux);
+    if (max_holders == 1) account();
+    if (max_holders > 0) max_holders--;
+    portEXIT_CRITICAL(&residency_mux);
+    if (lock) esp_pm_lock_release(lock);
+}
+
+void DynamicPower::renderBegin() {
+    acquireMax(render_lock);
+}
+
+void DynamicPower::renderEnd() {
+    releaseMax(render_lock);
+}
+
+void DynamicPower::flushBegin() {
+    acquireMax(flush_lock);
+}
+
+void DynamicPower::flushEnd() {
+    releaseMax(flush_lock);
+}
+
+void DynamicPower::setTouchActive(bool active) {
+    if (active == touch_active) return;
+    touch_active = active;
+    if (active) {
+        acquireMax(touch_lock);
+    } else {
+        releaseMax(touch_lock);
+    }
+}
+
+void DynamicPower::setDisplayOn(bool on) {
+    if (on == display_on) return;
+    portENTER_CRITICAL(&residency_mux);
+    account();
+    display_on = on;
+    portEXIT_CRITICAL(&residency_mux);
+
+    if (!display_lock) return;
+    if (on) {
+        armTouchWake(false);
+        esp_pm_lock_acquire(display_lock);
+    } else {
+        armTouchWake(true);
+        esp_pm_lock_release(display_lock);
+    }
+}
+
+// Light sleep only wakes on level triggers, while TouchDriver's INT interrupt is edge-triggered
+// (attachInterrupt FALLING). The pin is switched to low level for the dark period and back after
+void DynamicPower::armTouchWake(bool arm) {
+#if TOUCH_INT >= 0
+    if (!light_sleep) return;
+    gpio_num_t pin = (gpio_num_t)TOUCH_INT;
+    if (arm) {
+        touch_wake_armed = true;
+        gpio_wakeup_enable(pin, GPIO_INTR_LOW_LEVEL);
+    } else {
+        touch_wake_armed = false;
+        gpio_wakeup_disable(pin);
+        gpio_set_intr_type(pin, GPIO_INTR_NEGEDGE);
+        gpio_intr_enable(pin);
+    }
+#endif
+}
+
+// A level interrupt keeps firing while INT is low: take the first one, which starts the touch
+// read that wakes the panel, and leave the rest to the idle status poll until the screen is on
+void IRAM_ATTR DynamicPower::touchInterruptFromISR() {
+#if TOUCH_INT >= 0
+    if (touch_wake_armed) {
+        touch_wake_armed = false;
+        gpio_intr_disable((gpio_num_t)TOUCH_INT);
+    }
+#endif
+}
+
+void DynamicPower::dump() {
+    portENTER_CRITICAL(&residency_mux);
+    account();
+    uint64_t res[MODE_COUNT];
+    memcpy(res, residency_us, sizeof(res));
+    portEXIT_CRITICAL(&residency_mux);
+
+    uint64_t total = 0;
+    for (int i = 0; i < MODE_COUNT; i++) total += res[i];
+
+    Serial.println("\n=== Dynamic Power ===");
+    Serial.printf("  %s, CPU now %lu MHz, light sleep %s\n", configured ? "DFS on" : "DFS off",
+                  getCpuFrequencyMhz(), light_sleep ? "on (screen off only)" : "off");
+    for (int i = 0; i < MODE_COUNT; i++) {
+        Serial.printf("  %-16s %9.1f s  %5.1f%%\n", mode_names[i], res[i] / 1000000.0f,
+                      total ? res[i] * 100.0f / total : 0.0f);
+    }
+#ifdef CONFIG_PM_PROFILING
+    // Exact time per hardware mode, including locks held by other components
+    esp_pm_dump_locks(stdout);
+#endif
+}
+
+void DynamicPower::reset() {
+    portENTER_CRITICAL(&residency_mux);
+    memset(residency_us, 0, sizeof(residency_us));
+    since_us = esp_timer_get_time();
+    portEXIT_CRITICAL(&residency_mux);
+}
+
+void DynamicPower::consolePm(const char *args) {
+    if (strcmp(args, "reset") == 0) {
+        reset();
+        Serial.println("Dynamic power stats reset");
+    } else {
+        dump();
+    }
+}
@@ -0,0 +1,175 @@
+#include "core/font_store.h"
+#include "core/serial_console.h"
+#include <lvgl_private.h>
+#include <LittleFS.h>
+#include <esp_timer.h>
+
+// Static member initialization
+FontStore::Font FontStore::fonts[FONT_STORE_MAX];
+uint8_t FontStore::font_count = 0;
+lv_cache_t *FontStore::glyph_cache = nullptr;
+volatile uint32_t FontStore::hits = 0;
+volatile uint32_t FontStore::misses = 0;
+
+// One cached glyph, slot must come first (LRU-by-size cache accounting)
+struct CachedGlyph {
+    lv_cache_slot_size_t slot;
+    const lv_font_t *font;
+    uint32_t index;
+    lv_draw_buf_t *buf;
+};
+
+// Passed to glyph_create on a miss
+struct GlyphRequest {
+    lv_font_glyph_dsc_t *g_dsc;
+    const void *(*get_bitmap)(lv_font_glyph_dsc_t *g_dsc, lv_draw_buf_t *draw_buf);
+};
+
+static lv_cache_compare_res_t glyph_compare(const CachedGlyph *a, const CachedGlyph *b) {
+    if (a->font != b->font) return a->font > b->font ? 1 : -1;
+    if (a->index != b->index) return a->index > b->index ? 1 : -1;
+    return 0;
+}
+
+// Decompress the glyph once into its own A8 buffer in PSRAM
+static bool glyph_create(CachedGlyph *node, void *user_data) {
+    GlyphRequest *req = (GlyphRequest *)user_data;
+    lv_font_glyph_dsc_t *g = req->g_dsc;
+
+    node->buf = lv_draw_buf_create_ex(lv_draw_buf_get_image_handlers(), g->box_w, g->box_h,
+                                      LV_COLOR_FORMAT_A8, LV_STRIDE_AUTO);
+    if (!node->buf) return false;
+
+    if (!req->get_bitmap(g, node->buf)) {
+        lv_draw_buf_destroy(node->buf);
+        node->buf = nullptr;
+        return false;
+    }
+    node->slot.size = node->buf->data_size;
+    return true;
+}
+
+static void glyph_free(CachedGlyph *node, void *user_data) {
+    if (node->buf) lv_draw_buf_destroy(node->buf);
+    node->buf = nullptr;
+}
+
+void FontStore::init() {
+    if (!LittleFS.begin(false)) {
+        Serial.println("FontStore: WARNING: LittleFS mount failed, file fonts fall back to the default font");
+    }
+
+    lv_cache_ops_t ops = {
+        .compare_cb = (lv_cache_compare_cb_t)glyph_compare,
+        .create_cb = (lv_cache_create_cb_t)glyph_create,
+        .free_cb = (lv_cache_free_cb_t)glyph_free,
+    };
+    glyph_cache = lv_cache_create(&lv_cache_class_lru_rb_size, sizeof(CachedGlyph), FONT_GLYPH_CACHE_SIZE, ops);
+    lv_cache_set_name(glyph_cache, "GLYPH");
+
+    SerialConsole::registerCommand("fonts", "Loaded fonts and glyph cache stats: fonts [reset|drop]", consoleFonts);
+}
+
+const lv_font_t *FontStore::get(const char *name, uint8_t size) {
+    for (uint8_t i = 0; i < font_count; i++) {
+        if (fonts[i].size == size && strcmp(fonts[i].name, name) == 0) {
+            return fonts[i].font ? fonts[i].font : LV_FONT_DEFAULT;
+        }
+    }
+    if (font_count >= FONT_STORE_MAX) {
+        Serial.printf("FontStore: ERROR: Font table full, '%s' %d uses the default font\n", name, size);
+        return LV_FONT_DEFAULT;
+    }
+
+    // Remember failures too, so a missing file is only looked for once
+    Font &f = fonts[font_count++];
+    strlcpy(f.name, name, sizeof(f.name));
+    f.size = size;
+
+    char path[64];
+    snprintf(path, sizeof(path), "%c:" FONT_STORE_DIR "/%s_%d.bin", LV_FS_ARDUINO_ESP_LITTLEFS_LETTER, name, size);
+    uint32_t start = (uint32_t)esp_timer_get_time();
+    f.font = lv_binfont_create(path);
+    f.load_us = (uint32_t)esp_timer_get_time() - start;
+
+    if (!f.font) {
+        Serial.printf("FontStore: '%s' not found, using the default font\n", path);
+        return LV_FONT_DEFAULT;
+    }
+
+    // Route glyph bitmaps through the cache, fall back to the built-in font for missing glyphs
+    f.get_bitmap = f.font->get_glyph_bitmap;
+    f.font->get_glyph_bitmap = cachedGetBitmap;
+    f.font->release_glyph = cachedRelease;
+    f.font->user_data = &f;
+    f.font->fallback = LV_FONT_DEFAULT;
+
+    Serial.printf("FontStore: Loaded %s in %.1f ms\n", path, f.load_us / 1000.0f);
+    return f.font;
+}
+
+// Called by the draw units (possibly two at once), the cache has its own lock
+const void *FontStore::cachedGetBitmap(lv_font_glyph_dsc_t *g_dsc, lv_draw_buf_t *draw_buf) {
+    Font *f = (Font *)g_dsc->resolved_font->user_data;
+    if (g_dsc->req_raw_bitmap) return f->get_bitmap(g_dsc, draw_buf);
+
+    CachedGlyph key;
+    key.font = g_dsc->resolved_font;
+    key.index = g_dsc->gid.index;
+
+    lv_cache_entry_t *entry = lv_cache_acquire(glyph_cache, &key, NULL);
+    if (entry) {
+        hits++;
+    } else {
+        misses++;
+        GlyphRequest req = { g_dsc, f->get_bitmap };
+        entry = lv_cache_acquire_or_create(glyph_cache, &key, &req);
+        // Cache full of glyphs in use right now: decompress into the caller's buffer as before
+        if (!entry) return f->get_bitmap(g_dsc, draw_buf);
+    }
+
+    // Held until the glyph is drawn, so it cannot be evicted under the draw unit
+    g_dsc->entry = entry;
+    return ((CachedGlyph *)lv_cache_entry_get_data(entry))->buf;
+}
+
+void FontStore::cachedRelease(const lv_font_t *font, lv_font_glyph_dsc_t *g_dsc) {
+    if (g_dsc->entry) {
+        lv_cache_release(glyph_cache, g_dsc->entry, NULL);
+        g_dsc->entry = NULL;
+    }
+}
+
+void FontStore::dropGlyphs() {
+    lv_cache_drop_all(glyph_cache, NULL);
+}
+
+void FontStore::dump() {
+    uint32_t lookups = hits + misses;
+    Serial.printf("\n=== Fonts: %d loaded ===\n", font_count);
+    for (uint8_t i = 0; i < font_count; i++) {
+        Font &f = fonts[i];
+        Serial.printf("  %-16s %2d px  %s, load %.1f ms\n", f.name, f.size,
+                      f.font ? "from file" : "missing, default font", f.load_us / 1000.0f);
+    }
+    Serial.printf("  glyph cache %lu / %lu KB, hits %lu, misses %lu (%.1f%% hit rate)\n",
+                  lv_cache_get_size(glyph_cache, NULL) / 1024, lv_cache_get_max_size(glyph_cache, NULL) / 1024,
+                  hits, misses, lookups ? hits * 100.0f / lookups : 0.0f);
+}
+
+void FontStore::resetStats() {
+    hits = 0;
+    misses = 0;
+}
+
+void FontStore::consoleFonts(const char *args) {
+    if (strcmp(args, "reset") == 0) {
+        resetStats();
+        Serial.println("Font stats reset");
+    } else if (strcmp(args, "drop") == 0) {
+        dropGlyphs();
+        Serial.println("Glyph cache dropped");
+    } else {
+        dump();
+    }
+}
@@ -0,0 +1,183 @@
+#include "core/frame_stats.h"
+#include "core/serial_console.h"
+#include <esp_timer.h>
+#include <Arduino.h>
+
+// Static member initialization
+uint32_t FrameStats::frame_start_us = 0;
+uint32_t FrameStats::last_frame_start_us = 0;
+bool FrameStats::frame_rendered = false;
+uint32_t FrameStats::segment_start_us = 0;
+uint32_t FrameStats::frame_render_us = 0;
+uint32_t FrameStats::frame_wait_us = 0;
+volatile uint32_t FrameStats::frame_copy_us = 0;
+uint32_t FrameStats::frame_pixels = 0;
+uint32_t FrameStats::frame_areas = 0;
+uint64_t FrameStats::copy_total_us = 0;
+
+Histogram FrameStats::frame_time(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS);
+Histogram FrameStats::render_time(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS);
+Histogram FrameStats::wait_time(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS);
+Histogram FrameStats::copy_time(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS);
+Histogram FrameStats::frame_interval(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS);
+Histogram FrameStats::pixels(Histogram::PIXEL_BOUNDS, Histogram::PIXEL_BUCKETS);
+Histogram FrameStats::areas(Histogram::COUNT_BOUNDS, Histogram::COUNT_BUCKETS);
+
+lv_obj_t *FrameStats::overlay = nullptr;
+lv_timer_t *FrameStats::overlay_timer = nullptr;
+
+static inline uint32_t now_us() {
+    return (uint32_t)esp_timer_get_time();
+}
+
+void FrameStats::init(lv_display_t *disp) {
+    lv_display_add_event_cb(disp, event_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(disp, event_cb, LV_EVENT_RENDER_START, NULL);
+    lv_display_add_event_cb(disp, event_cb, LV_EVENT_REFR_READY, NULL);
+
+#if FRAME_STATS_INTERVAL_MS > 0
+    lv_timer_create(report_timer_cb, FRAME_STATS_INTERVAL_MS, NULL);
+#endif
+
+    SerialConsole::registerCommand("stats", "Frame stats: stats [reset|overlay on|overlay off]", consoleStats);
+
+#if FRAME_STATS_OVERLAY
+    setOverlay(true);
+#endif
+}
+
+void FrameStats::flushBegin(const lv_area_t *area) {
+    frame_render_us += now_us() - segment_start_us;
+    frame_pixels += lv_area_get_size(area);
+    frame_areas++;
+}
+
+void FrameStats::flushEnd() {
+    segment_start_us = now_us();
+}
+
+void FrameStats::waitBegin() {
+    uint32_t now = now_us();
+    frame_render_us += now - segment_start_us;
+    segment_start_us = now;
+}
+
+void FrameStats::waitEnd() {
+    uint32_t now = now_us();
+    frame_wait_us += now - segment_start_us;
+    segment_start_us = now;
+}
+
+void FrameStats::addCopyTime(uint32_t us) {
+    frame_copy_us += us;
+    copy_total_us += us;
+}
+
+void FrameStats::event_cb(lv_event_t *e) {
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_REFR_START:
+            frame_start_us = now_us();
+            frame_rendered = false;
+            break;
+
+        case LV_EVENT_RENDER_START:
+            frame_rendered = true;
+            segment_start_us = now_us();
+            frame_render_us = 0;
+            frame_wait_us = 0;
+            frame_copy_us = 0;
+            frame_pixels = 0;
+            frame_areas = 0;
+            break;
+
+        case LV_EVENT_REFR_READY:
+            // Refreshes with nothing to draw are not frames
+            if (frame_rendered) {
+                frame_time.add(now_us() - frame_start_us);
+                render_time.add(frame_render_us);
+                wait_time.add(frame_wait_us);
+                copy_time.add(frame_copy_us);
+                pixels.add(frame_pixels);
+                areas.add(frame_areas);
+                if (last_frame_start_us != 0) frame_interval.add(frame_start_us - last_frame_start_us);
+                last_frame_start_us = frame_start_us;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void FrameStats::printHistogram(const char *name, const Histogram &h, const char *unit, float scale) {
+    Serial.printf("  %-10s p50 %8.2f  p95 %8.2f  p99 %8.2f  max %8.2f  mean %8.2f %s\n", name,
+                  h.percentile(50) / scale, h.percentile(95) / scale, h.percentile(99) / scale,
+                  h.max() / scale, h.mean() / scale, unit);
+}
+
+void FrameStats::dump() {
+    Serial.printf("\n=== Frame Stats [%s], %lu frames ===\n",
+                  DISPLAY_RENDER_MODE == DISPLAY_RENDER_DIRECT ? "direct" : "partial",
+                  frame_time.count());
+    if (frame_time.count() == 0) return;
+
+    printHistogram("frame", frame_time, "ms", 1000.0f);
+    printHistogram("render", render_time, "ms", 1000.0f);
+    printHistogram("wait", wait_time, "ms", 1000.0f);
+    printHistogram("copy", copy_time, "ms", 1000.0f);
+    printHistogram("interval", frame_interval, "ms", 1000.0f);
+    printHistogram("pixels", pixels, "px", 1.0f);
+    printHistogram("areas", areas, "", 1.0f);
+}
+
+void FrameStats::reset() {
+    frame_time.reset();
+    render_time.reset();
+    wait_time.reset();
+    copy_time.reset();
+    frame_interval.reset();
+    pixels.reset();
+    areas.reset();
+    last_frame_start_us = 0;
+}
+
+void FrameStats::setOverlay(bool enabled) {
+    if (enabled && !overlay) {
+        overlay = lv_label_create(lv_layer_top());
+        lv_obj_align(overlay, LV_ALIGN_BOTTOM_RIGHT, -4, -4);
+        lv_obj_set_style_bg_color(overlay, lv_color_black(), 0);
+        lv_obj_set_style_bg_opa(overlay, LV_OPA_70, 0);
+        lv_obj_set_style_text_color(overlay, lv_color_white(), 0);
+        lv_obj_set_style_pad_all(overlay, 4, 0);
+        lv_label_set_text(overlay, "");
+        overlay_timer = lv_timer_create(overlay_timer_cb, 1000, NULL);
+    } else if (!enabled && overlay) {
+        lv_timer_delete(overlay_timer);
+        lv_obj_delete(overlay);
+        overlay_timer = nullptr;
+        overlay = nullptr;
+    }
+}
+
+void FrameStats::report_timer_cb(lv_timer_t *timer) {
+    dump();
+}
+
+void FrameStats::overlay_timer_cb(lv_timer_t *timer) {
+    lv_label_set_text_fmt(overlay, "frame p50 %lu p95 %lu ms\nrender p50 %lu p95 %lu ms",
+                          frame_time.percentile(50) / 1000, frame_time.percentile(95) / 1000,
+                          render_time.percentile(50) / 1000, render_time.percentile(95) / 1000);
+}
+
+void FrameStats::consoleStats(const char *args) {
+    if (strcmp(args, "reset") == 0) {
+        reset();
+        Serial.println("Frame stats reset");
+    } else if (strcmp(args, "overlay on") == 0) {
+        setOverlay(true);
+    } else if (strcmp(args, "overlay off") == 0) {
+        setOverlay(false);
+    } else {
+        dump();
+    }
+}
@@ -0,0 +1,152 @@
+#include "core/gesture.h"
+#include <math.h>
+#include <stdlib.h>
+
+void GestureRecognizer::reset() {
+    mode = NONE;
+    start_ms = 0;
+    start_x = start_y = 0;
+    at_edge = false;
+    edge_dir = Gesture::RIGHT;
+    start_dist = 0;
+    last_x = last_y = 0;
+    last_scale_q8 = 256;
+}
+
+uint8_t GestureRecognizer::update(const TouchPoint *points, uint8_t count, uint32_t now_ms, Gesture *out) {
+    uint8_t n = 0;
+
+    // All fingers lifted: close a pinch in progress, then start over
+    if (count == 0) {
+        if (mode == PINCHING) {
+            Gesture g = make(Gesture::PINCH, Gesture::END, last_x, last_y);
+            g.scale_q8 = last_scale_q8;
+            out[n++] = g;
+        }
+        mode = NONE;
+        return n;
+    }
+
+    if (count == 1) {
+        const TouchPoint &p = points[0];
+
+        if (mode == NONE) {
+            mode = ONE;
+            start_ms = now_ms;
+            start_x = p.x;
+            start_y = p.y;
+
+            at_edge = true;
+            if (p.x < GESTURE_EDGE_PX) edge_dir = Gesture::RIGHT;
+            else if (p.x >= SCREEN_WIDTH - GESTURE_EDGE_PX) edge_dir = Gesture::LEFT;
+            else if (p.y < GESTURE_EDGE_PX) edge_dir = Gesture::DOWN;
+            else if (p.y >= SCREEN_HEIGHT - GESTURE_EDGE_PX) edge_dir = Gesture::UP;
+            else at_edge = false;
+            return n;
+        }
+
+        // Lifting one of two fingers ends a pinch, the other finger does nothing more
+        if (mode == PINCHING) {
+            Gesture g = make(Gesture::PINCH, Gesture::END, last_x, last_y);
+            g.scale_q8 = last_scale_q8;
+            out[n++] = g;
+            mode = MULTI_DONE;
+            return n;
+        }
+        if (mode != ONE) return n;
+
+        int32_t dx = p.x - start_x;
+        int32_t dy = p.y - start_y;
+
+        if (at_edge) {
+            // Distance travelled inward and sideways for the edge the finger started on
+            int32_t inward = edge_dir == Gesture::RIGHT ? dx : edge_dir == Gesture::LEFT ? -dx
+                           : edge_dir == Gesture::DOWN ? dy : -dy;
+            int32_t side = (edge_dir == Gesture::RIGHT || edge_dir == Gesture::LEFT) ? abs(dy) : abs(dx);
+            if (inward >= GESTURE_SWIPE_MIN_PX && side < inward) {
+                Gesture g = make(Gesture::EDGE_SWIPE, Gesture::END, p.x, p.y);
+                g.dir = edge_dir;
+                out[n++] = g;
+                mode = ONE_DONE;
+                return n;
+            }
+        }
+
+        if (abs(dx) > GESTURE_SLOP_PX || abs(dy) > GESTURE_SLOP_PX) {
+            // Dragging: no long press, an edge swipe may still complete
+            if (!at_edge) mode = ONE_DONE;
+        } else if (now_ms - start_ms >= GESTURE_LONG_PRESS_MS) {
+            out[n++] = make(Gesture::LONG_PRESS, Gesture::END, p.x, p.y);
+            mode = ONE_DONE;
+        }
+        return n;
+    }
+
+    // Two or more fingers: the first two reported drive the gesture
+    const TouchPoint &a = points[0];
+    const TouchPoint &b = points[1];
+    int16_t cx = (a.x + b.x) / 2;
+    int16_t cy = (a.y + b.y) / 2;
+    float dist = sqrtf((float)(a.x - b.x) * (a.x - b.x) + (float)(a.y - b.y) * (a.y - b.y));
+
+    if (mode == NONE || mode == ONE || mode == ONE_DONE) {
+        mode = TWO;
+        start_x = cx;
+        start_y = cy;
+        start_dist = dist > 1.0f ? dist : 1.0f;
+        last_x = cx;
+        last_y = cy;
+        last_scale_q8 = 256;
+        return n;
+    }
+    if (mode == MULTI_DONE) return n;
+
+    int32_t scale_q8 = (int32_t)(dist * 256.0f / start_dist);
+    last_x = cx;
+    last_y = cy;
+
+    if (mode == TWO) {
+        int32_t dx = cx - start_x;
+        int32_t dy = cy - start_y;
+        if (fabsf(dist - start_dist) >= GESTURE_PINCH_MIN_PX) {
+            mode = PINCHING;
+            Gesture g = make(Gesture::PINCH, Gesture::BEGIN, cx, cy);
+            g.scale_q8 = scale_q8;
+            out[n++] = g;
+            last_scale_q8 = scale_q8;
+        } else if (abs(dx) >= GESTURE_SWIPE_MIN_PX || abs(dy) >= GESTURE_SWIPE_MIN_PX) {
+            Gesture g = make(Gesture::TWO_FINGER_SWIPE, Gesture::END, cx, cy);
+            g.dir = dominantDir(dx, dy);
+            out[n++] = g;
+            mode = MULTI_DONE;
+        }
+        return n;
+    }
+
+    // PINCHING: report every change of scale
+    if (scale_q8 != last_scale_q8) {
+        Gesture g = make(Gesture::PINCH, Gesture::UPDATE, cx, cy);
+        g.scale_q8 = scale_q8;
+        out[n++] = g;
+        last_scale_q8 = scale_q8;
+    }
+    return n;
+}
+
+Gesture::Dir GestureRecognizer::dominantDir(int32_t dx, int32_t dy) {
+    if (abs(dx) >= abs(dy)) return dx > 0 ? Gesture::RIGHT : Gesture::LEFT;
+    return dy > 0 ? Gesture::DOWN : Gesture::UP;
+}
+
+Gesture GestureRecognizer::make(Gesture::Type type, Gesture::Phase phase, int16_t x, int16_t y) const {
+    Gesture g;
+    g.type = type;
+    g.phase = phase;
+    g.dir = Gesture::RIGHT;
+    g.start_x = start_x;
+    g.start_y = start_y;
+    g.x = x;
+    g.y = y;
+    g.scale_q8 = 256;
+    return g;
+}
@@ -0,0 +1,58 @@
+#include "core/histogram.h"
+#include "config.h"
+
+const uint32_t Histogram::TIME_US_BOUNDS[] = {
+    100, 200, 300, 500, 750, 1000, 1500, 2000, 3000, 4000, 5000, 6000, 8000, 10000, 12500, 15000,
+    17500, 20000, 25000, 30000, 35000, 40000, 50000, 60000, 75000, 100000, 125000, 150000, 200000,
+    300000, 500000, UINT32_MAX
+};
+const uint8_t Histogram::TIME_US_BUCKETS = sizeof(TIME_US_BOUNDS) / sizeof(TIME_US_BOUNDS[0]);
+
+const uint32_t Histogram::PIXEL_BOUNDS[] = {
+    64, 256, 1024, 2048, 4096, 8192, 16384, 32768, 49152, 65536, 98304, 131072, 196608, 262144,
+    SCREEN_WIDTH * SCREEN_HEIGHT, UINT32_MAX
+};
+const uint8_t Histogram::PIXEL_BUCKETS = sizeof(PIXEL_BOUNDS) / sizeof(PIXEL_BOUNDS[0]);
+
+const uint32_t Histogram::COUNT_BOUNDS[] = {
+    0, 1, 2, 3, 4, 5, 6, 8, 10, 12, 16, 20, 24, 32, UINT32_MAX
+};
+const uint8_t Histogram::COUNT_BUCKETS = sizeof(COUNT_BOUNDS) / sizeof(COUNT_BOUNDS[0]);
+
+Histogram::Histogram(const uint32_t *bounds, uint8_t bucket_count)
+    : bounds(bounds), bucket_count(bucket_count > MAX_BUCKETS ? MAX_BUCKETS : bucket_count) {
+    reset();
+}
+
+void Histogram::add(uint32_t value) {
+    uint8_t b = 0;
+    while (b < bucket_count - 1 && value > bounds[b]) b++;
+    buckets[b]++;
+    samples++;
+    sum += value;
+    if (value > max_value) max_value = value;
+}
+
+void Histogram::reset() {
+    for (uint8_t b = 0; b < MAX_BUCKETS; b++) buckets[b] = 0;
+    samples = 0;
+    max_value = 0;
+    sum = 0;
+}
+
+uint32_t Histogram::percentile(uint8_t p) const {
+    if (samples == 0) return 0;
+
+    // Rank of the sample at the p-th percentile, rounded up
+    uint32_t rank = (uint32_t)(((uint64_t)samples * p + 99) / 100);
+    if (rank == 0) rank = 1;
+
+    uint32_t seen = 0;
+    for (uint8_t b = 0; b < bucket_count; b++) {
+        seen += buckets[b];
+        if (seen >= rank) {
+            return bounds[b] < max_value ? bounds[b] : max_value;
+        }
+    }
+    return max_value;
+}
@@ -0,0 +1,177 @@
+#include "core/i2c_bus.h"
+#include "core/serial_console.h"
+#include <LovyanGFX.hpp>
+#include <esp_timer.h>
+
+// Static member initialization
+int I2cBus::port = 0;
+TaskHandle_t I2cBus::task_handle = nullptr;
+I2cBus::PollFn I2cBus::poller = nullptr;
+volatile uint32_t I2cBus::poll_period_ms = TOUCH_ACTIVE_POLL_MS;
+volatile bool I2cBus::touch_kicked = false;
+I2cBus::Pending I2cBus::slots[I2cBus::SLOT_COUNT] = {};
+uint32_t I2cBus::coalesced = 0;
+I2cBus::Device I2cBus::devices[I2C_BUS_MAX_DEVICES] = {
+    { 0, 0, Histogram(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS) },
+    { 0, 0, Histogram(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS) },
+    { 0, 0, Histogram(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS) },
+    { 0, 0, Histogram(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS) },
+};
+uint8_t I2cBus::device_count = 0;
+
+// Slots are written from any task, stats read by the console task
+static portMUX_TYPE slot_mux = portMUX_INITIALIZER_UNLOCKED;
+static portMUX_TYPE stats_mux = portMUX_INITIALIZER_UNLOCKED;
+
+void I2cBus::start(int i2c_port) {
+    port = i2c_port;
+    xTaskCreatePinnedToCore(run, "i2c", 4096, NULL, I2C_TASK_PRIO, &task_handle, I2C_TASK_CORE);
+    SerialConsole::registerCommand("i2c", "I2C bus transactions per device: i2c [reset]", consoleI2c);
+    Serial.printf("I2C bus task started on core %d (port %d)\n", I2C_TASK_CORE, port);
+}
+
+void I2cBus::setTouchPoller(PollFn fn, uint32_t period_ms) {
+    poll_period_ms = period_ms;
+    poller = fn;
+    kickTouch();
+}
+
+void I2cBus::setTouchPeriod(uint32_t period_ms) {
+    if (period_ms == poll_period_ms) return;
+    poll_period_ms = period_ms;
+    kickTouch();  // Reschedule with the new period
+}
+
+void I2cBus::kickTouch() {
+    touch_kicked = true;
+    if (task_handle) xTaskNotifyGive(task_handle);
+}
+
+void IRAM_ATTR I2cBus::kickTouchFromISR() {
+    touch_kicked = true;
+    if (!task_handle) return;
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(task_handle, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
+void I2cBus::post(Slot slot, uint8_t addr, uint8_t value, uint32_t freq) {
+    portENTER_CRITICAL(&slot_mux);
+    if (slots[slot].valid) coalesced++;
+    slots[slot] = { true, addr, value, freq };
+    portEXIT_CRITICAL(&slot_mux);
+    if (task_handle) xTaskNotifyGive(task_handle);
+}
+
+bool I2cBus::flush(uint32_t timeout_ms) {
+    uint32_t start = millis();
+    while (millis() - start < timeout_ms) {
+        bool pending = false;
+        portENTER_CRITICAL(&slot_mux);
+        for (uint8_t i = 0; i < SLOT_COUNT; i++) pending |= slots[i].valid;
+        portEXIT_CRITICAL(&slot_mux);
+        if (!pending) return true;
+        delay(1);
+    }
+    return false;
+}
+
+bool I2cBus::writeRead(uint8_t addr, const uint8_t *wbuf, uint8_t wlen, uint8_t *rbuf, uint8_t rlen, uint32_t freq) {
+    uint32_t start = (uint32_t)esp_timer_get_time();
+    bool ok = lgfx::i2c::transactionWriteRead(port, addr, wbuf, wlen, rbuf, rlen, freq).has_value();
+    record(addr, (uint32_t)esp_timer_get_time() - start, ok);
+    return ok;
+}
+
+bool I2cBus::write(uint8_t addr, const uint8_t *wbuf, uint8_t wlen, uint32_t freq) {
+    uint32_t start = (uint32_t)esp_timer_get_time();
+    bool ok = lgfx::i2c::transactionWrite(port, addr, wbuf, wlen, freq).has_value();
+    record(addr, (uint32_t)esp_timer_get_time() - start, ok);
+    return ok;
+}
+
+void I2cBus::run(void *param) {
+    TickType_t next_poll = xTaskGetTickCount();
+
+    while (true) {
+        // Touch first: due by the clock or kicked by the INT line / a period change
+        TickType_t now = xTaskGetTickCount();
+        if (poller && (touch_kicked || (int32_t)(now - next_poll) >= 0)) {
+            touch_kicked = false;
+            poller();
+            next_poll = xTaskGetTickCount() + pdMS_TO_TICKS(poll_period_ms);
+        }
+
+        // Then the latest value of each slot, stopping early if the touch wants the bus again
+        for (uint8_t i = 0; i < SLOT_COUNT && !touch_kicked; i++) {
+            portENTER_CRITICAL(&slot_mux);
+            Pending p = slots[i];
+            portEXIT_CRITICAL(&slot_mux);
+            if (!p.valid) continue;
+
+            write(p.addr, &p.value, 1, p.freq);
+
+            // Only clear the slot if nobody posted a newer value while it was on the wire
+            portENTER_CRITICAL(&slot_mux);
+            if (slots[i].value == p.value && slots[i].addr == p.addr) slots[i].valid = false;
+            portEXIT_CRITICAL(&slot_mux);
+        }
+        if (touch_kicked) continue;
+
+        TickType_t wait = portMAX_DELAY;
+        if (poller) {
+            now = xTaskGetTickCount();
+            wait = (int32_t)(next_poll - now) > 0 ? next_poll - now : 0;
+        }
+        ulTaskNotifyTake(pdTRUE, wait);
+    }
+}
+
+void I2cBus::record(uint8_t addr, uint32_t elapsed_us, bool ok) {
+    portENTER_CRITICAL(&stats_mux);
+    Device *dev = nullptr;
+    for (uint8_t i = 0; i < device_count; i++) {
+        if (devices[i].addr == addr) dev = &devices[i];
+    }
+    if (!dev && device_count < I2C_BUS_MAX_DEVICES) {
+        dev = &devices[device_count++];
+        dev->addr = addr;
+    }
+    if (dev) {
+        dev->time.add(elapsed_us);
+        if (!ok) dev->errors++;
+    }
+    portEXIT_CRITICAL(&stats_mux);
+}
+
+void I2cBus::dump() {
+    Serial.println("\n=== I2C Bus ===");
+    for (uint8_t i = 0; i < device_count; i++) {
+        portENTER_CRITICAL(&stats_mux);
+        Device dev = devices[i];
+        portEXIT_CRITICAL(&stats_mux);
+        Serial.printf("  0x%02X: %lu transactions, %lu errors, p50 %.2f ms, p95 %.2f ms, max %.2f ms\n",
+                      dev.addr, dev.time.count(), dev.errors, dev.time.percentile(50) / 1000.0f,
+                      dev.time.percentile(95) / 1000.0f, dev.time.max() / 1000.0f);
+    }
+    Serial.printf("  %lu writes coalesced, touch poll every %lu ms\n", coalesced, poll_period_ms);
+}
+
+void I2cBus::reset() {
+    portENTER_CRITICAL(&stats_mux);
+    for (uint8_t i = 0; i < device_count; i++) {
+        devices[i].errors = 0;
+        devices[i].time.reset();
+    }
+    coalesced = 0;
+    portEXIT_CRITICAL(&stats_mux);
+}
+
+void I2cBus::consoleI2c(const char *args) {
+    if (strcmp(args, "reset") == 0) {
+        reset();
+        Serial.println("I2C bus stats reset");
+    } else {
+        dump();
+    }
+}
@@ -0,0 +1,183 @@
+#include "core/image_cache.h"
+#include "core/serial_console.h"
+#include <lvgl_private.h>
+#include <esp_heap_caps.h>
+
+// Static member initialization
+ImageCache::Pin ImageCache::pins[IMAGE_CACHE_MAX_PINS];
+uint8_t ImageCache::pin_count = 0;
+volatile uint32_t ImageCache::hits = 0;
+volatile uint32_t ImageCache::misses = 0;
+volatile uint32_t ImageCache::evictions = 0;
+lv_cache_class_t ImageCache::counted_class;
+const lv_cache_class_t *ImageCache::lru_class = nullptr;
+
+void ImageCache::init() {
+    lv_cache_t *cache = LV_GLOBAL_DEFAULT()->img_cache;
+    if (!cache) {
+        Serial.println("ImageCache: ERROR: LVGL image cache not created");
+        return;
+    }
+
+    // Same LRU class LVGL created the cache with, lookups and evictions counted on the way through
+    lru_class = cache->clz;
+    counted_class = *lru_class;
+    counted_class.get_cb = cacheGet;
+    counted_class.get_victim_cb = cacheGetVictim;
+    cache->clz = &counted_class;
+
+    // Decoded images live in PSRAM, internal SRAM stays free for draw buffers and Wi-Fi
+    lv_draw_buf_handlers_t *handlers = lv_draw_buf_get_image_handlers();
+    handlers->buf_malloc_cb = buf_malloc;
+    handlers->buf_free_cb = buf_free;
+
+    // Keep the pins in step with the active screen: screen loads, new images, changed sources
+    lv_timer_create(screen_timer_cb, IMAGE_CACHE_PIN_CHECK_MS, NULL);
+
+    SerialConsole::registerCommand("cache", "Image cache: cache [reset|drop|budget <KB>]", consoleCache);
+
+    Serial.printf("ImageCache: %lu KB budget in PSRAM, %d header entries\n",
+                  lv_cache_get_max_size(cache, NULL) / 1024, LV_IMAGE_HEADER_CACHE_DEF_CNT);
+}
+
+// Runs with the cache lock held, a miss is followed by a decode and an add
+lv_cache_entry_t *ImageCache::cacheGet(lv_cache_t *cache, const void *key, void *user_data) {
+    lv_cache_entry_t *entry = lru_class->get_cb(cache, key, user_data);
+    if (entry) hits++;
+    else misses++;
+    return entry;
+}
+
+// Runs with the cache lock held, every victim returned here is removed and freed
+lv_cache_entry_t *ImageCache::cacheGetVictim(lv_cache_t *cache, void *user_data) {
+    lv_cache_entry_t *victim = lru_class->get_victim_cb(cache, user_data);
+    if (victim) evictions++;
+    return victim;
+}
+
+void *ImageCache::buf_malloc(size_t size, lv_color_format_t cf) {
+    // LVGL aligns the returned pointer itself, leave room for it
+    return heap_caps_malloc(size + LV_DRAW_BUF_ALIGN - 1, MALLOC_CAP_SPIRAM);
+}
+
+void ImageCache::buf_free(void *buf) {
+    heap_caps_free(buf);
+}
+
+// A pin is an open decoder session: it holds a reference on the cache entry, which the LRU never evicts
+bool ImageCache::pin(const void *src) {
+    if (!src) return false;
+    for (uint8_t i = 0; i < pin_count; i++) {
+        if (pins[i].src == src) return true;
+    }
+    if (pin_count >= IMAGE_CACHE_MAX_PINS) {
+        Serial.println("ImageCache: Pin table full");
+        return false;
+    }
+
+    Pin &p = pins[pin_count];
+    if (lv_image_decoder_open(&p.dsc, src, NULL) != LV_RESULT_OK) return false;
+    p.src = src;
+    p.automatic = false;
+    p.seen = true;
+    pin_count++;
+    return true;
+}
+
+void ImageCache::unpin(const void *src) {
+    for (uint8_t i = 0; i < pin_count; i++) {
+        if (pins[i].src == src) {
+            lv_image_decoder_close(&pins[i].dsc);
+            pins[i] = pins[--pin_count];
+            return;
+        }
+    }
+}
+
+void ImageCache::unpinAutomatic(bool unseen_only) {
+    for (uint8_t i = 0; i < pin_count; ) {
+        if (pins[i].automatic && !(unseen_only && pins[i].seen)) {
+            lv_image_decoder_close(&pins[i].dsc);
+            pins[i] = pins[--pin_count];
+        } else {
+            i++;
+        }
+    }
+}
+
+void ImageCache::pinTree(lv_obj_t *obj) {
+    if (lv_obj_has_flag(obj, LV_OBJ_FLAG_HIDDEN)) return;
+
+    if (lv_obj_check_type(obj, &lv_image_class)) {
+        const void *src = lv_image_get_src(obj);
+        // Symbols are drawn as text, only image descriptors and files go through the decoders
+        if (src && lv_image_src_get_type(src) != LV_IMAGE_SRC_SYMBOL) {
+            uint8_t i = 0;
+            while (i < pin_count && pins[i].src != src) i++;
+            if (i < pin_count) {
+                pins[i].seen = true;
+            } else if (pin_count < IMAGE_CACHE_MAX_PINS && pin(src)) {  // Full table: no message every tick
+                pins[pin_count - 1].automatic = true;
+            }
+        }
+    }
+
+    uint32_t count = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < count; i++) {
+        pinTree(lv_obj_get_child(obj, i));
+    }
+}
+
+// Mark and sweep: pins still in use stay open, new sources are pinned, the rest released
+void ImageCache::pinScreen(lv_obj_t *screen) {
+    for (uint8_t i = 0; i < pin_count; i++) pins[i].seen = false;
+    if (screen) pinTree(screen);
+    unpinAutomatic(true);
+}
+
+// A full walk of the active screen every tick, cheap at a few dozen objects, catches sources
+// set after the screen was built (the wallpaper) and images created later
+void ImageCache::screen_timer_cb(lv_timer_t *timer) {
+    pinScreen(lv_screen_active());
+}
+
+void ImageCache::setBudget(uint32_t bytes) {
+    lv_image_cache_resize(bytes, true);
+}
+
+void ImageCache::dump() {
+    lv_cache_t *cache = LV_GLOBAL_DEFAULT()->img_cache;
+    uint32_t lookups = hits + misses;
+
+    Serial.printf("\n=== Image Cache ===\n");
+    Serial.printf("  used %lu / %lu KB, %d pinned\n",
+                  lv_cache_get_size(cache, NULL) / 1024, lv_cache_get_max_size(cache, NULL) / 1024, pin_count);
+    Serial.printf("  hits %lu, misses %lu (%.1f%% hit rate), evictions %lu\n",
+                  hits, misses, lookups ? hits * 100.0f / lookups : 0.0f, evictions);
+    Serial.printf("  free PSRAM %u bytes\n", heap_caps_get_free_size(MALLOC_CAP_SPIRAM));
+}
+
+void ImageCache::resetStats() {
+    hits = 0;
+    misses = 0;
+    evictions = 0;
+}
+
+void ImageCache::consoleCache(const char *args) {
+    if (strcmp(args, "reset") == 0) {
+        resetStats();
+        Serial.println("Image cache stats reset");
+    } else if (strcmp(args, "drop") == 0) {
+        // Everything is decoded again on next use, entries still held are freed once released
+        lv_image_cache_drop(NULL);
+        unpinAutomatic(false);
+        pinScreen(lv_screen_active());
+        Serial.println("Image cache dropped");
+    } else if (strncmp(args, "budget ", 7) == 0) {
+        uint32_t kb = strtoul(args + 7, NULL, 10);
+        setBudget(kb * 1024);
+        Serial.printf("Image cache budget set to %lu KB\n", kb);
+    } else {
+        dump();
+    }
+}
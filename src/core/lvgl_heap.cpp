@@ -0,0 +1,221 @@
+#include "core/lvgl_heap.h"
+#include "core/serial_console.h"
+#include <esp_heap_caps.h>
+#include <multi_heap.h>
+
+// The arena is a multi_heap of its own, so it has its own free lists and fragmentation,
+// and LVGL cannot eat into the SRAM Wi-Fi and the DMA stripes need
+static uint8_t *arena = nullptr;
+static multi_heap_handle_t arena_heap = nullptr;
+static portMUX_TYPE arena_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Per-tier usage, guarded by stats_lock (draw units allocate from other tasks)
+struct Tier {
+    size_t used;
+    size_t peak;
+    uint32_t count;
+};
+static portMUX_TYPE stats_lock = portMUX_INITIALIZER_UNLOCKED;
+static Tier sram_tier = {};
+static Tier psram_tier = {};
+static uint32_t fallbacks = 0;  // Small allocations that went to PSRAM because the arena was full
+
+static inline bool in_arena(const void *p) {
+    return arena && (const uint8_t *)p >= arena && (const uint8_t *)p < arena + LVGL_HEAP_SRAM_SIZE;
+}
+
+static void account(Tier &tier, size_t size, bool add) {
+    portENTER_CRITICAL(&stats_lock);
+    if (add) {
+        tier.used += size;
+        tier.count++;
+        if (tier.used > tier.peak) tier.peak = tier.used;
+    } else {
+        tier.used -= size;
+        tier.count--;
+    }
+    portEXIT_CRITICAL(&stats_lock);
+}
+
+static void *sram_alloc(size_t size) {
+    void *p = multi_heap_malloc(arena_heap, size);
+    if (p) account(sram_tier, multi_heap_get_allocated_size(arena_heap, p), true);
+    return p;
+}
+
+static void sram_free(void *p) {
+    account(sram_tier, multi_heap_get_allocated_size(arena_heap, p), false);
+    multi_heap_free(arena_heap, p);
+}
+
+static void *psram_alloc(size_t size) {
+    void *p = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (p) account(psram_tier, heap_caps_get_allocated_size(p), true);
+    return p;
+}
+
+static void psram_free(void *p) {
+    account(psram_tier, heap_caps_get_allocated_size(p), false);
+    heap_caps_free(p);
+}
+
+extern "C" {
+
+void lv_mem_init(void) {
+    arena = (uint8_t *)heap_caps_malloc(LVGL_HEAP_SRAM_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (arena) {
+        arena_heap = multi_heap_register(arena, LVGL_HEAP_SRAM_SIZE);
+        multi_heap_set_lock(arena_heap, &arena_lock);
+    }
+    if (!arena_heap) {
+        // Everything in PSRAM, same as the old builtin pool
+        heap_caps_free(arena);
+        arena = nullptr;
+    }
+}
+
+void lv_mem_deinit(void) {
+    // Nothing to do, LVGL is never deinitialized on the panel
+}
+
+lv_mem_pool_t lv_mem_add_pool(void *mem, size_t bytes) {
+    LV_UNUSED(mem);
+    LV_UNUSED(bytes);
+    return NULL;
+}
+
+void lv_mem_remove_pool(lv_mem_pool_t pool) {
+    LV_UNUSED(pool);
+}
+
+void *lv_malloc_core(size_t size) {
+    if (size <= LVGL_HEAP_SMALL_MAX && arena_heap) {
+        void *p = sram_alloc(size);
+        if (p) return p;
+        portENTER_CRITICAL(&stats_lock);
+        fallbacks++;
+        portEXIT_CRITICAL(&stats_lock);
+    }
+    return psram_alloc(size);
+}
+
+void lv_free_core(void *p) {
+    if (!p) return;
+    if (in_arena(p)) sram_free(p);
+    else psram_free(p);
+}
+
+void *lv_realloc_core(void *p, size_t new_size) {
+    if (!p) return lv_malloc_core(new_size);
+
+    if (in_arena(p)) {
+        size_t old_size = multi_heap_get_allocated_size(arena_heap, p);
+        if (new_size <= LVGL_HEAP_SMALL_MAX) {
+            void *q = multi_heap_realloc(arena_heap, p, new_size);
+            if (q) {
+                account(sram_tier, old_size, false);
+                account(sram_tier, multi_heap_get_allocated_size(arena_heap, q), true);
+                return q;
+            }
+        }
+        // Grown past the small limit or the arena is full: move it to PSRAM
+        void *q = psram_alloc(new_size);
+        if (!q) return NULL;
+        memcpy(q, p, old_size < new_size ? old_size : new_size);
+        sram_free(p);
+        return q;
+    }
+
+    // PSRAM blocks stay in PSRAM, a shrinking buffer is usually about to grow again
+    size_t old_size = heap_caps_get_allocated_size(p);
+    void *q = heap_caps_realloc(p, new_size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (q) {
+        account(psram_tier, old_size, false);
+        account(psram_tier, heap_caps_get_allocated_size(q), true);
+    }
+    return q;
+}
+
+void lv_mem_monitor_core(lv_mem_monitor_t *mon_p) {
+    multi_heap_info_t info = {};
+    if (arena_heap) multi_heap_get_info(arena_heap, &info);
+    size_t arena_size = arena_heap ? LVGL_HEAP_SRAM_SIZE : 0;
+
+    // LVGL's view covers the SRAM arena, the tier it has to stay within
+    mon_p->total_size = arena_size;
+    mon_p->free_size = info.total_free_bytes;
+    mon_p->free_biggest_size = info.largest_free_block;
+    mon_p->free_cnt = info.free_blocks;
+    mon_p->used_cnt = sram_tier.count + psram_tier.count;
+    mon_p->max_used = sram_tier.peak;
+    mon_p->used_pct = arena_size ? (arena_size - info.total_free_bytes) * 100 / arena_size : 0;
+    mon_p->frag_pct = info.total_free_bytes ? 100 - info.largest_free_block * 100 / info.total_free_bytes : 0;
+}
+
+lv_result_t lv_mem_test_core(void) {
+    if (arena_heap && !multi_heap_check(arena_heap, true)) return LV_RESULT_INVALID;
+    return LV_RESULT_OK;
+}
+
+}  // extern "C"
+
+void LvglHeap::init() {
+    if (!arena_heap) {
+        Serial.printf("LvglHeap: WARNING: No %d KB SRAM arena, all LVGL allocations in PSRAM\n",
+                      LVGL_HEAP_SRAM_SIZE / 1024);
+    } else {
+        Serial.printf("LvglHeap: %d KB SRAM arena for allocations up to %d bytes, PSRAM above\n",
+                      LVGL_HEAP_SRAM_SIZE / 1024, LVGL_HEAP_SMALL_MAX);
+    }
+
+    SerialConsole::registerCommand("mem", "LVGL heap tiers: mem [reset]", consoleMem);
+}
+
+size_t LvglHeap::usedBytes() {
+    portENTER_CRITICAL(&stats_lock);
+    size_t used = sram_tier.used + psram_tier.used;
+    portEXIT_CRITICAL(&stats_lock);
+    return used;
+}
+
+void LvglHeap::dump() {
+    multi_heap_info_t info = {};
+    if (arena_heap) multi_heap_get_info(arena_heap, &info);
+
+    portENTER_CRITICAL(&stats_lock);
+    Tier sram = sram_tier;
+    Tier psram = psram_tier;
+    uint32_t fallback_count = fallbacks;
+    portEXIT_CRITICAL(&stats_lock);
+
+    // Fragmentation: how much of the free space is unusable for one allocation of its total size
+    size_t p_free = heap_caps_get_free_size(MALLOC_CAP_SPIRAM);
+    size_t p_largest = heap_caps_get_largest_free_block(MALLOC_CAP_SPIRAM);
+
+    Serial.println("\n=== LVGL Heap ===");
+    Serial.printf("  SRAM arena: %u / %u bytes in %lu blocks, peak %u, largest free %u, frag %u%%\n",
+                  sram.used, arena_heap ? LVGL_HEAP_SRAM_SIZE : 0, sram.count, sram.peak,
+                  info.largest_free_block,
+                  info.total_free_bytes ? 100 - info.largest_free_block * 100 / info.total_free_bytes : 0);
+    Serial.printf("  PSRAM:      %u bytes in %lu blocks, peak %u, largest free %u of %u (frag %u%%, whole PSRAM heap)\n",
+                  psram.used, psram.count, psram.peak, p_largest, p_free,
+                  p_free ? 100 - p_largest * 100 / p_free : 0);
+    Serial.printf("  Small allocations sent to PSRAM (arena full): %lu\n", fallback_count);
+}
+
+void LvglHeap::resetPeak() {
+    portENTER_CRITICAL(&stats_lock);
+    sram_tier.peak = sram_tier.used;
+    psram_tier.peak = psram_tier.used;
+    fallbacks = 0;
+    portEXIT_CRITICAL(&stats_lock);
+}
+
+void LvglHeap::consoleMem(const char *args) {
+    if (strcmp(args, "reset") == 0) {
+        resetPeak();
+        Serial.println("LVGL heap peaks reset");
+    } else {
+        dump();
+    }
+}
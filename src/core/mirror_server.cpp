@@ -0,0 +1,354 @@
+#include "core/mirror_server.h"
+#include "core/screenshot_server.h"
+#include "core/serial_console.h"
+#include "core/touch_driver.h"
+#include "core/lvgl_lock.h"
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
+#include <Arduino.h>
+
+#define MIRROR_STR_(x) #x
+#define MIRROR_STR(x) MIRROR_STR_(x)
+
+// Area record header: 'A' x y w h len
+#define AREA_HEADER_SIZE 13
+
+// Static member initialization
+DisplayDriver *MirrorServer::display = nullptr;
+WebSocketsServer *MirrorServer::ws = nullptr;
+RingbufHandle_t MirrorServer::ring = nullptr;
+StaticRingbuffer_t MirrorServer::ring_struct;
+uint8_t *MirrorServer::tx = nullptr;
+size_t MirrorServer::tx_len = 0;
+volatile uint8_t MirrorServer::clients = 0;
+volatile bool MirrorServer::keyframe_needed = false;
+uint32_t MirrorServer::frame_seq = 0;
+uint32_t MirrorServer::frame_bytes = 0;
+uint32_t MirrorServer::frame_sent_us[MIRROR_ACK_SLOTS];
+Histogram MirrorServer::bytes_per_frame(Histogram::PIXEL_BOUNDS, Histogram::PIXEL_BUCKETS);
+Histogram MirrorServer::ack_latency(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS);
+uint32_t MirrorServer::dropped = 0;
+uint32_t MirrorServer::keyframes = 0;
+
+// Encode scratch for the flush path (UI task), one band of an area at a time
+static uint8_t *scratch = nullptr;
+
+static const char MIRROR_PAGE[] = R"rawliteral(<!DOCTYPE html>
+<html><head><meta name="viewport" content="width=device-width"><title>HomePanel mirror</title>
+<style>body{background:#222;color:#ccc;font:13px monospace;margin:8px}canvas{touch-action:none;max-width:100%}</style>
+</head><body><canvas id="c" width="800" height="480"></canvas><div id="s">connecting...</div>
+<script>
+const c = document.getElementById('c'), ctx = c.getContext('2d'), st = document.getElementById('s');
+const ws = new WebSocket('ws://' + location.hostname + ':)rawliteral" MIRROR_STR(MIRROR_PORT) R"rawliteral(/');
+ws.binaryType = 'arraybuffer';
+let frames = 0, bytes = 0, t0 = performance.now();
+ws.onopen = () => st.textContent = 'connected';
+ws.onclose = () => st.textContent = 'disconnected';
+ws.onmessage = (ev) => {
+  const d = new DataView(ev.data), u8 = new Uint8Array(ev.data);
+  bytes += u8.length;
+  for (let p = 0; p < u8.length; ) {
+    const t = u8[p];
+    if (t === 0x41) {
+      const x = d.getUint16(p + 1, true), y = d.getUint16(p + 3, true), w = d.getUint16(p + 5, true),
+            h = d.getUint16(p + 7, true), len = d.getUint32(p + 9, true);
+      const img = ctx.createImageData(w, h), o = img.data;
+      let i = p + 13, end = i + len, k = 0;
+      const px = () => { const v = (u8[i] << 8) | u8[i + 1]; i += 2;
+        o[k] = ((v >> 11) & 31) * 255 / 31; o[k + 1] = ((v >> 5) & 63) * 255 / 63; o[k + 2] = (v & 31) * 255 / 31; o[k + 3] = 255; k += 4; };
+      while (i < end) {
+        const ctl = u8[i++];
+        if (ctl & 0x80) { px(); const n = ctl & 0x7f; for (let r = 0; r < n; r++, k += 4) o.copyWithin(k, k - 4, k); }
+        else for (let n = ctl + 1; n > 0; n--) px();
+      }
+      ctx.putImageData(img, x, y);
+      p = end;
+    } else if (t === 0x46) {
+      const a = new Uint8Array(5); a[0] = 0x46; a.set(u8.subarray(p + 1, p + 5), 1); ws.send(a);
+      frames++; p += 9;
+    } else break;
+  }
+  const s = (performance.now() - t0) / 1000;
+  if (s > 1) { st.textContent = (frames / s).toFixed(1) + ' fps, ' + (bytes / s / 1024).toFixed(1) + ' KB/s'; frames = 0; bytes = 0; t0 = performance.now(); }
+};
+let down = false;
+const touch = (e, pressed) => {
+  const r = c.getBoundingClientRect(), x = (e.clientX - r.left) * c.width / r.width, y = (e.clientY - r.top) * c.height / r.height;
+  const b = new DataView(new ArrayBuffer(6)); b.setUint8(0, 0x54); b.setUint16(1, x, true); b.setUint16(3, y, true); b.setUint8(5, pressed ? 1 : 0);
+  if (ws.readyState === 1) ws.send(b.buffer);
+};
+c.onpointerdown = (e) => { down = true; c.setPointerCapture(e.pointerId); touch(e, true); };
+c.onpointermove = (e) => { if (down) touch(e, true); };
+c.onpointerup = (e) => { down = false; touch(e, false); };
+</script></body></html>
+)rawliteral";
+
+// RLE on RGB565, runs of 3 or more identical pixels become 3 bytes, everything else is literal
+// Runs and literals do not cross rows so the area can be read with any stride
+size_t mirror_rle_encode(const uint16_t *px, uint32_t w, uint32_t h, uint32_t stride, uint8_t *out) {
+    uint8_t *o = out;
+    for (uint32_t row = 0; row < h; row++, px += stride) {
+        uint32_t x = 0;
+        while (x < w) {
+            uint16_t v = px[x];
+            uint32_t run = 1;
+            while (x + run < w && run < 128 && px[x + run] == v) run++;
+            if (run >= 3) {
+                *o++ = 0x80 | (run - 1);
+                memcpy(o, &v, 2);
+                o += 2;
+                x += run;
+                continue;
+            }
+
+            uint32_t start = x;
+            uint32_t n = 0;
+            while (x < w && n < 128) {
+                if (x + 2 < w && px[x] == px[x + 1] && px[x] == px[x + 2]) break;
+                x++;
+                n++;
+            }
+            *o++ = n - 1;
+            memcpy(o, px + start, n * 2);
+            o += n * 2;
+        }
+    }
+    return o - out;
+}
+
+static inline void put_le16(uint8_t *p, uint16_t v) {
+    p[0] = v;
+    p[1] = v >> 8;
+}
+
+static inline void put_le32(uint8_t *p, uint32_t v) {
+    p[0] = v;
+    p[1] = v >> 8;
+    p[2] = v >> 16;
+    p[3] = v >> 24;
+}
+
+static inline uint32_t get_le32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static size_t encode_area_record(uint8_t *out, int32_t x, int32_t y, uint32_t w, uint32_t h,
+                                 const uint16_t *px, uint32_t stride) {
+    size_t len = mirror_rle_encode(px, w, h, stride, out + AREA_HEADER_SIZE);
+    out[0] = 'A';
+    put_le16(out + 1, x);
+    put_le16(out + 3, y);
+    put_le16(out + 5, w);
+    put_le16(out + 7, h);
+    put_le32(out + 9, len);
+    return AREA_HEADER_SIZE + len;
+}
+
+void MirrorServer::init(DisplayDriver *driver) {
+    display = driver;
+
+    // Delta ring and send buffer in PSRAM, the encode scratch in internal SRAM next to the draw buffers
+    uint8_t *ring_storage = (uint8_t *)heap_caps_malloc(MIRROR_RING_SIZE, MALLOC_CAP_SPIRAM);
+    tx = (uint8_t *)heap_caps_malloc(MIRROR_TX_SIZE, MALLOC_CAP_SPIRAM);
+    scratch = (uint8_t *)heap_caps_malloc(AREA_HEADER_SIZE + 3 * MIRROR_BAND_PIXELS, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (ring_storage) {
+        ring = xRingbufferCreateStatic(MIRROR_RING_SIZE, RINGBUF_TYPE_NOSPLIT, ring_storage, &ring_struct);
+    }
+    if (!ring || !tx || !scratch) {
+        Serial.println("MirrorServer: ERROR: Failed to allocate buffers, mirror disabled");
+        return;
+    }
+
+    ws = new WebSocketsServer(MIRROR_PORT);
+    ws->onEvent(wsEvent);
+    ws->begin();
+
+    if (ScreenshotServer::getWebServer()) {
+        ScreenshotServer::getWebServer()->on("/mirror", HTTP_GET, handlePage);
+    }
+
+    DisplayDriver::setFlushObserver(flushObserver);
+    lv_display_add_event_cb(driver->getDisplay(), event_cb, LV_EVENT_REFR_READY, NULL);
+    SerialConsole::registerCommand("mirror", "Mirror stats: mirror [reset]", consoleMirror);
+
+    xTaskCreatePinnedToCore(task, "mirror", 6144, NULL, 1, NULL, MIRROR_TASK_CORE);
+    Serial.printf("MirrorServer: WebSocket on port %d, viewer at /mirror\n", MIRROR_PORT);
+}
+
+// Flush path (UI task): encode the area band by band into the ring, never blocks
+void MirrorServer::flushObserver(const lv_area_t *area, const uint16_t *px, uint32_t stride) {
+    if (clients == 0 || keyframe_needed) return;
+
+    uint32_t w = lv_area_get_width(area);
+    uint32_t h = lv_area_get_height(area);
+    uint32_t band = MIRROR_BAND_PIXELS / w;
+    if (band == 0) band = 1;
+
+    for (uint32_t y = 0; y < h; y += band) {
+        uint32_t lines = h - y < band ? h - y : band;
+        size_t len = encode_area_record(scratch, area->x1, area->y1 + y, w, lines, px + y * stride, stride);
+        if (xRingbufferSend(ring, scratch, len, 0) != pdTRUE) {
+            // Sender fell behind, resync the client with a keyframe instead of queueing more
+            dropped++;
+            keyframe_needed = true;
+            return;
+        }
+        frame_bytes += len;
+    }
+}
+
+void MirrorServer::event_cb(lv_event_t *e) {
+    if (clients == 0 || keyframe_needed || frame_bytes == 0) return;
+
+    uint8_t rec[9];
+    rec[0] = 'F';
+    put_le32(rec + 1, frame_seq);
+    put_le32(rec + 5, frame_bytes);
+    if (xRingbufferSend(ring, rec, sizeof(rec), 0) == pdTRUE) {
+        frame_sent_us[frame_seq % MIRROR_ACK_SLOTS] = (uint32_t)esp_timer_get_time();
+        bytes_per_frame.add(frame_bytes);
+        frame_seq++;
+    }
+    frame_bytes = 0;
+}
+
+void MirrorServer::wsEvent(uint8_t num, WStype_t type, uint8_t *payload, size_t length) {
+    switch (type) {
+        case WStype_CONNECTED:
+            clients++;
+            keyframe_needed = true;
+            Serial.printf("MirrorServer: Client %d connected (%d total)\n", num, clients);
+            break;
+
+        case WStype_DISCONNECTED:
+            if (clients > 0) clients--;
+            Serial.printf("MirrorServer: Client %d disconnected (%d total)\n", num, clients);
+            break;
+
+        case WStype_BIN:
+            for (size_t p = 0; p < length; ) {
+                if (payload[p] == 'T' && p + 6 <= length) {
+                    int16_t x = payload[p + 1] | (payload[p + 2] << 8);
+                    int16_t y = payload[p + 3] | (payload[p + 4] << 8);
+                    TouchDriver::injectTouch(x, y, payload[p + 5] != 0);
+                    p += 6;
+                } else if (payload[p] == 'F' && p + 5 <= length) {
+                    uint32_t seq = get_le32(payload + p + 1);
+                    if (frame_seq - seq > 0 && frame_seq - seq < MIRROR_ACK_SLOTS) {
+                        ack_latency.add((uint32_t)esp_timer_get_time() - frame_sent_us[seq % MIRROR_ACK_SLOTS]);
+                    }
+                    p += 5;
+                } else if (payload[p] == 'K') {
+                    keyframe_needed = true;
+                    p += 1;
+                } else {
+                    break;
+                }
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void MirrorServer::task(void *param) {
+    while (true) {
+        ws->loop();
+
+        if (clients == 0) {
+            vTaskDelay(pdMS_TO_TICKS(20));
+            continue;
+        }
+
+        if (keyframe_needed) sendKeyframe();
+
+        // Batch queued records into as few WebSocket messages as possible, a frame end goes out immediately
+        size_t len;
+        void *item;
+        while ((item = xRingbufferReceive(ring, &len, pdMS_TO_TICKS(tx_len ? 0 : 10))) != nullptr) {
+            bool frame_end = ((uint8_t *)item)[0] == 'F';
+            put(item, len);
+            vRingbufferReturnItem(ring, item);
+            if (frame_end) break;
+        }
+        flushTx();
+    }
+}
+
+// Full frame, encoded straight from the panel framebuffer a few lines per LVGL lock hold
+void MirrorServer::sendKeyframe() {
+    const uint16_t *fb = display->getLCD()->_panel_instance.getFrameBuffer();
+    if (!fb) return;
+
+    {
+        // Anything queued before this point is superseded by the keyframe
+        LvglLock lock;
+        keyframe_needed = false;
+        frame_bytes = 0;
+        size_t len;
+        void *item;
+        while ((item = xRingbufferReceive(ring, &len, 0)) != nullptr) vRingbufferReturnItem(ring, item);
+
+        // Areas skipped by the observer while keyframe_needed was set may still be on their way
+        // to the framebuffer (PARTIAL), let them land. Later flushes are observed and follow it
+        display->waitForFlush();
+    }
+    tx_len = 0;
+
+    const uint32_t max_record = AREA_HEADER_SIZE + 3 * SCREEN_WIDTH * MIRROR_KEYFRAME_LINES;
+    for (uint32_t y = 0; y < SCREEN_HEIGHT; y += MIRROR_KEYFRAME_LINES) {
+        uint32_t lines = SCREEN_HEIGHT - y < MIRROR_KEYFRAME_LINES ? SCREEN_HEIGHT - y : MIRROR_KEYFRAME_LINES;
+        if (tx_len + max_record > MIRROR_TX_SIZE) flushTx();
+
+        LvglLock lock;
+        tx_len += encode_area_record(tx + tx_len, 0, y, SCREEN_WIDTH, lines, fb + y * SCREEN_WIDTH, SCREEN_WIDTH);
+    }
+    flushTx();
+    keyframes++;
+}
+
+void MirrorServer::put(const void *data, size_t len) {
+    if (tx_len + len > MIRROR_TX_SIZE) flushTx();
+    memcpy(tx + tx_len, data, len);
+    tx_len += len;
+}
+
+void MirrorServer::flushTx() {
+    if (tx_len == 0) return;
+    ws->broadcastBIN(tx, tx_len);
+    tx_len = 0;
+}
+
+void MirrorServer::handlePage() {
+    ScreenshotServer::getWebServer()->send(200, "text/html", MIRROR_PAGE);
+}
+
+void MirrorServer::dump() {
+    Serial.printf("\n=== Mirror: %d client(s), %lu frames, %lu keyframes, %lu overflows ===\n",
+                  clients, bytes_per_frame.count(), keyframes, dropped);
+    if (bytes_per_frame.count() == 0) return;
+    Serial.printf("  bytes/frame p50 %lu  p95 %lu  max %lu  mean %lu\n",
+                  bytes_per_frame.percentile(50), bytes_per_frame.percentile(95),
+                  bytes_per_frame.max(), bytes_per_frame.mean());
+    if (ack_latency.count() == 0) return;
+    Serial.printf("  frame->ack  p50 %.2f  p95 %.2f  max %.2f ms\n",
+                  ack_latency.percentile(50) / 1000.0f, ack_latency.percentile(95) / 1000.0f,
+                  ack_latency.max() / 1000.0f);
+}
+
+void MirrorServer::reset() {
+    bytes_per_frame.reset();
+    ack_latency.reset();
+    dropped = 0;
+    keyframes = 0;
+}
+
+void MirrorServer::consoleMirror(const char *args) {
+    if (strcmp(args, "reset") == 0) {
+        reset();
+        Serial.println("Mirror stats reset");
+    } else {
+        dump();
+    }
+}
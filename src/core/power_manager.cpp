@@ -6,6 +6,11 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <esp_sleep.h>
+#include "core/lvgl_lock.h"
+#ifndef HOMEPANEL_NATIVE
+#include "core/serial_console.h"
+#include "core/dynamic_power.h"
+#endif
 
 // Static member initialization
 DisplayDriver* PowerManager::display_driver = nullptr;
@@ -18,13 +23,26 @@ uint8_t PowerManager::dim_brightness = 10;           // Default: 25% brightness
 uint32_t PowerManager::last_activity_ms = 0;
 PowerManager::PowerState PowerManager::current_state = PowerManager::FULL_BRIGHTNESS;
 bool PowerManager::state_changed = false;
+PowerManager::StateStats PowerManager::state_stats[3] = {};
+uint32_t PowerManager::state_since_us = 0;
+bool PowerManager::wake_pending = false;
+
+static const char *const state_names[] = { "FULL_BRIGHTNESS", "DIMMED", "SCREEN_OFF" };
 
 void PowerManager::init(DisplayDriver* driver) {
     display_driver = driver;
     last_activity_ms = millis();
     current_state = FULL_BRIGHTNESS;
+    state_since_us = micros();
     loadSettings();
 
+    if (display_driver && display_driver->getDisplay()) {
+        lv_display_add_event_cb(display_driver->getDisplay(), render_event_cb, LV_EVENT_RENDER_START, NULL);
+    }
+#ifndef HOMEPANEL_NATIVE
+    SerialConsole::registerCommand("power", "Time, UI busy and frames per power state: power [reset]", consolePower);
+#endif
+
     Serial.println("\n=== Power Manager Initialized ===");
     Serial.printf("Enabled: %s\n", enabled ? "YES" : "NO");
     Serial.printf("Dim timeout: %d seconds\n", dim_timeout_sec);
@@ -87,6 +105,36 @@ void PowerManager::update(int machine_state) {
     }
 }
 
+uint32_t PowerManager::msUntilNextDeadline() {
+    if (!enabled || display_driver == nullptr) {
+        return UINT32_MAX;
+    }
+
+    // Next timeout for the current state, same thresholds as update()
+    uint32_t deadline_ms = UINT32_MAX;
+    switch (current_state) {
+        case FULL_BRIGHTNESS:
+            if (dim_timeout_sec > 0) deadline_ms = dim_timeout_sec * 1000;
+            break;
+
+        case DIMMED:
+            if (sleep_timeout_sec > 0) deadline_ms = sleep_timeout_sec * 1000;
+            break;
+
+        case SCREEN_OFF:
+            break;
+    }
+    if (deep_sleep_timeout_sec > 0 && deep_sleep_timeout_sec * 1000 < deadline_ms) {
+        deadline_ms = deep_sleep_timeout_sec * 1000;
+    }
+    if (deadline_ms == UINT32_MAX) {
+        return UINT32_MAX;
+    }
+
+    uint32_t idle_ms = millis() - last_activity_ms;
+    return idle_ms >= deadline_ms ? 0 : deadline_ms - idle_ms;
+}
+
 void PowerManager::loadSettings() {
     Preferences prefs;
     prefs.begin(PREFS_SYSTEM_NAMESPACE, true);  // Read-only
@@ -200,26 +248,50 @@ void PowerManager::setDimBrightness(uint8_t brightness) {
 
 void PowerManager::applyNormalBrightness() {
     if (display_driver) {
-        display_driver->setBacklight(normal_brightness);
-        // Also update state to full brightness
-        current_state = FULL_BRIGHTNESS;
+        if (current_state != FULL_BRIGHTNESS) {
+            enterFullBrightness();
+        } else {
+            display_driver->setBacklight(normal_brightness);
+        }
     }
 }
 
+// Instant, cuts a dim or off fade short when a touch arrives mid-fade
 void PowerManager::enterFullBrightness() {
     if (current_state != FULL_BRIGHTNESS) {
         Serial.printf("PowerManager: Entering FULL_BRIGHTNESS (brightness=%d)\n", normal_brightness);
-        display_driver->setBacklight(normal_brightness);
-        current_state = FULL_BRIGHTNESS;
+        bool was_off = current_state == SCREEN_OFF;
+        setState(FULL_BRIGHTNESS);
+        if (was_off) {
+            // Usually called from the touch read inside LVGL's indev timer: the full redraw
+            // waits for finishWake() at the end of the pass instead of stalling input here
+            wake_pending = true;
+        } else {
+            display_driver->setBacklight(normal_brightness);
+        }
         state_changed = true;
     }
 }
 
+void PowerManager::finishWake() {
+    if (!wake_pending) return;
+    wake_pending = false;
+    if (current_state == SCREEN_OFF || !display_driver) return;
+
+    // Nothing was drawn while off: redraw once and get it to the panel before it lights up
+    lv_display_t *disp = display_driver->getDisplay();
+    lv_obj_invalidate(lv_display_get_screen_active(disp));
+    lv_obj_invalidate(lv_display_get_layer_top(disp));
+    lv_refr_now(disp);
+    display_driver->waitForFlush();
+    display_driver->setBacklight(current_state == DIMMED ? dim_brightness : normal_brightness);
+}
+
 void PowerManager::enterDimmed() {
     if (current_state != DIMMED) {
         Serial.printf("PowerManager: Entering DIMMED (brightness=%d)\n", dim_brightness);
-        display_driver->setBacklight(dim_brightness);
-        current_state = DIMMED;
+        display_driver->fadeBacklight(dim_brightness, BACKLIGHT_DIM_FADE_MS);
+        setState(DIMMED);
         state_changed = true;
     }
 }
@@ -227,12 +299,92 @@ void PowerManager::enterDimmed() {
 void PowerManager::enterScreenOff() {
     if (current_state != SCREEN_OFF) {
         Serial.println("PowerManager: Entering SCREEN_OFF");
-        display_driver->setBacklightOff();
-        current_state = SCREEN_OFF;
+        display_driver->fadeBacklight(0, BACKLIGHT_OFF_FADE_MS);
+        setState(SCREEN_OFF);
         state_changed = true;
     }
 }
 
+void PowerManager::setState(PowerState state) {
+    uint32_t now = micros();
+    state_stats[current_state].time_us += now - state_since_us;
+    state_since_us = now;
+    current_state = state;
+    applyRenderPolicy(state);
+#ifndef HOMEPANEL_NATIVE
+    // Light sleep stops the RGB scanout, only allowed while the panel is off
+    DynamicPower::setDisplayOn(state != SCREEN_OFF);
+#endif
+}
+
+// Rendering follows the backlight: nobody sees frames drawn while the screen is off, and a
+// dimmed panel nobody is looking at does not need the full refresh rate
+void PowerManager::applyRenderPolicy(PowerState state) {
+    lv_display_t *disp = display_driver ? display_driver->getDisplay() : nullptr;
+    if (!disp) return;
+    lv_timer_t *refr = lv_display_get_refr_timer(disp);
+
+    switch (state) {
+        case FULL_BRIGHTNESS:
+        case DIMMED:
+            lv_display_enable_invalidation(disp, true);
+            lv_timer_set_period(refr, state == DIMMED ? DIMMED_REFR_PERIOD_MS : LV_DEF_REFR_PERIOD);
+            lv_timer_resume(refr);
+            // LVGL keeps the animation timer paused itself while no animation exists
+            if (lv_anim_count_running() > 0) lv_timer_resume(lv_anim_get_timer());
+            break;
+
+        case SCREEN_OFF:
+            // No invalidation means nothing to render even if something resumes the timers,
+            // waking redraws the whole screen instead
+            lv_display_enable_invalidation(disp, false);
+            lv_timer_pause(refr);
+            lv_timer_pause(lv_anim_get_timer());
+            break;
+    }
+}
+
+void PowerManager::addBusyTime(uint32_t busy_us) {
+    state_stats[current_state].busy_us += busy_us;
+}
+
+void PowerManager::render_event_cb(lv_event_t *e) {
+    state_stats[current_state].frames++;
+}
+
+void PowerManager::dumpStats() {
+    // Close the current state's interval so the numbers are up to date
+    uint32_t now = micros();
+    state_stats[current_state].time_us += now - state_since_us;
+    state_since_us = now;
+
+    Serial.println("\n=== Power States ===");
+    Serial.println("  (current draw is not measured, the board has no sensor: busy % is the proxy)");
+    for (int i = 0; i < 3; i++) {
+        const StateStats &st = state_stats[i];
+        float secs = st.time_us / 1000000.0f;
+        Serial.printf("  %-16s %9.1f s  UI busy %5.1f%%  %7lu frames (%.1f/s)%s\n", state_names[i], secs,
+                      st.time_us ? st.busy_us * 100.0f / st.time_us : 0.0f, (unsigned long)st.frames,
+                      secs > 0 ? st.frames / secs : 0.0f, i == current_state ? "  <- now" : "");
+    }
+}
+
+void PowerManager::resetStats() {
+    for (int i = 0; i < 3; i++) state_stats[i] = {};
+    state_since_us = micros();
+}
+
+// Console task on the other core, the stats belong to the UI pass
+void PowerManager::consolePower(const char *args) {
+    LvglLock lock;
+    if (strcmp(args, "reset") == 0) {
+        resetStats();
+        Serial.println("Power stats reset");
+    } else {
+        dumpStats();
+    }
+}
+
 void PowerManager::enterDeepSleep() {
     Serial.println("PowerManager: Entering DEEP SLEEP due to inactivity");
 
@@ -0,0 +1,267 @@
+#include "core/retained_bitmap.h"
+#include "core/serial_console.h"
+#include <lvgl_private.h>
+#include <esp_timer.h>
+
+// Static member initialization
+RetainedBitmap RetainedBitmap::pool[RETAINED_BITMAP_MAX];
+uint8_t RetainedBitmap::pool_count = 0;
+bool RetainedBitmap::capturing = false;
+uint32_t RetainedBitmap::hit_frames = 0;
+uint32_t RetainedBitmap::capture_count = 0;
+uint64_t RetainedBitmap::capture_total_us = 0;
+uint64_t RetainedBitmap::saved_total_us = 0;
+bool RetainedBitmap::frame_hit = false;
+
+// Per refresh
+static bool frame_captured = false;
+static uint32_t frame_saved_us = 0;
+
+// Everything an object draws, replaced by the bitmap blit while it is valid
+static const lv_event_code_t draw_events[] = {
+    LV_EVENT_DRAW_MAIN_BEGIN, LV_EVENT_DRAW_MAIN, LV_EVENT_DRAW_MAIN_END,
+    LV_EVENT_DRAW_POST_BEGIN, LV_EVENT_DRAW_POST, LV_EVENT_DRAW_POST_END,
+};
+
+RetainedBitmap *RetainedBitmap::create(lv_obj_t *root, lv_obj_t *backdrop) {
+    RetainedBitmap *rb = nullptr;
+    for (uint8_t i = 0; i < pool_count; i++) {
+        if (!pool[i].root) rb = &pool[i];
+    }
+    if (!rb) {
+        if (pool_count >= RETAINED_BITMAP_MAX) {
+            Serial.println("RetainedBitmap: ERROR: Pool full");
+            return nullptr;
+        }
+        rb = &pool[pool_count++];
+    }
+
+    // Display hooks and the console command are shared by all retained subtrees
+    static bool hooked = false;
+    if (!hooked) {
+        lv_display_t *disp = lv_obj_get_display(root);
+        lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_INVALIDATE_AREA, NULL);
+        lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_RENDER_START, NULL);
+        lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_REFR_READY, NULL);
+        SerialConsole::registerCommand("retained", "Retained bitmap stats: retained [reset]", consoleRetained);
+        hooked = true;
+    }
+
+    rb->root = root;
+    rb->backdrop = backdrop;
+    rb->bitmap = nullptr;
+    rb->stale = true;
+    rb->capture_us = 0;
+
+    for (lv_event_code_t code : draw_events) {
+        lv_obj_add_event_cb(root, root_draw_cb, (lv_event_code_t)(code | LV_EVENT_PREPROCESS), rb);
+    }
+    if (backdrop) {
+        lv_obj_add_event_cb(root, cover_check_cb, (lv_event_code_t)(LV_EVENT_COVER_CHECK | LV_EVENT_PREPROCESS), rb);
+    }
+    lv_obj_add_event_cb(root, delete_cb, LV_EVENT_DELETE, rb);
+
+    uint32_t count = lv_obj_get_child_count(root);
+    for (uint32_t i = 0; i < count; i++) {
+        retainTree(lv_obj_get_child(root, i), rb);
+    }
+
+    lv_obj_invalidate(root);
+    return rb;
+}
+
+void RetainedBitmap::retainTree(lv_obj_t *obj, RetainedBitmap *rb) {
+    for (lv_event_code_t code : draw_events) {
+        lv_obj_add_event_cb(obj, child_draw_cb, (lv_event_code_t)(code | LV_EVENT_PREPROCESS), rb);
+    }
+    uint32_t count = lv_obj_get_child_count(obj);
+    for (uint32_t i = 0; i < count; i++) {
+        retainTree(lv_obj_get_child(obj, i), rb);
+    }
+}
+
+// Render backdrop + subtree into the bitmap, same approach as lv_snapshot
+bool RetainedBitmap::capture() {
+    lv_area_t a = root->coords;
+    int32_t ext = lv_obj_get_ext_draw_size(root);
+    lv_area_increase(&a, ext, ext);
+    lv_area_t screen = { 0, 0, SCREEN_WIDTH - 1, SCREEN_HEIGHT - 1 };
+    if (!lv_area_intersect(&a, &a, &screen)) return false;
+
+    // Opaque when the backdrop is baked in, otherwise blended over whatever is underneath
+    lv_color_format_t cf = backdrop ? LV_COLOR_FORMAT_RGB565 : LV_COLOR_FORMAT_ARGB8888;
+    uint32_t w = lv_area_get_width(&a);
+    uint32_t h = lv_area_get_height(&a);
+    if (!bitmap || bitmap->header.w != w || bitmap->header.h != h) {
+        if (bitmap) lv_draw_buf_destroy(bitmap);
+        // Image handlers allocate in PSRAM (see ImageCache)
+        bitmap = lv_draw_buf_create_ex(lv_draw_buf_get_image_handlers(), w, h, cf, LV_STRIDE_AUTO);
+        if (!bitmap) {
+            Serial.printf("RetainedBitmap: ERROR: No memory for %lux%lu bitmap\n", w, h);
+            return false;
+        }
+    }
+    area = a;
+
+    uint32_t start = (uint32_t)esp_timer_get_time();
+    lv_draw_buf_clear(bitmap, NULL);
+
+    lv_layer_t layer;
+    lv_layer_init(&layer);
+    layer.draw_buf = bitmap;
+    layer.buf_area = a;
+    layer.color_format = cf;
+    layer._clip_area = a;
+    layer.phy_clip_area = a;
+
+    lv_display_t *disp = lv_obj_get_display(root);
+    lv_display_t *disp_old = lv_refr_get_disp_refreshing();
+    lv_layer_t *layer_old = disp->layer_head;
+    disp->layer_head = &layer;
+    lv_refr_set_disp_refreshing(disp);
+
+    capturing = true;
+    if (backdrop) lv_obj_redraw(&layer, backdrop);
+    lv_obj_redraw(&layer, root);
+    while (layer.draw_task_head) {
+        lv_draw_dispatch_wait_for_request();
+        lv_draw_dispatch();
+    }
+    capturing = false;
+
+    disp->layer_head = layer_old;
+    lv_refr_set_disp_refreshing(disp_old);
+
+    // Same buffer, new pixels: make sure no decoder state keyed on it survives
+    lv_image_cache_drop(bitmap);
+
+    capture_us = (uint32_t)esp_timer_get_time() - start;
+    return true;
+}
+
+void RetainedBitmap::root_draw_cb(lv_event_t *e) {
+    RetainedBitmap *rb = (RetainedBitmap *)lv_event_get_user_data(e);
+    if (capturing || !rb->bitmap || rb->stale) return;  // Draw normally
+
+    if (lv_event_get_code(e) == LV_EVENT_DRAW_MAIN) {
+        lv_layer_t *layer = lv_event_get_layer(e);
+        lv_draw_image_dsc_t dsc;
+        lv_draw_image_dsc_init(&dsc);
+        dsc.src = rb->bitmap;
+        lv_draw_image(layer, &dsc, &rb->area);
+
+        // Saving estimate: the blitted share of what the subtree last cost to render
+        lv_area_t drawn;
+        if (lv_area_intersect(&drawn, &layer->_clip_area, &rb->area)) {
+            frame_saved_us += (uint64_t)rb->capture_us * lv_area_get_size(&drawn) / lv_area_get_size(&rb->area);
+        }
+        frame_hit = true;
+    }
+    lv_event_stop_processing(e);
+}
+
+void RetainedBitmap::child_draw_cb(lv_event_t *e) {
+    RetainedBitmap *rb = (RetainedBitmap *)lv_event_get_user_data(e);
+    if (capturing || !rb->bitmap || rb->stale) return;
+    lv_event_stop_processing(e);
+}
+
+// With the backdrop baked in the bitmap is opaque: LVGL can start drawing here
+void RetainedBitmap::cover_check_cb(lv_event_t *e) {
+    RetainedBitmap *rb = (RetainedBitmap *)lv_event_get_user_data(e);
+    if (capturing || !rb->bitmap || rb->stale) return;
+
+    const lv_area_t *a = lv_event_get_cover_area(e);
+    if (lv_area_is_in(a, &rb->root->coords, 0)) {
+        lv_event_set_cover_res(e, LV_COVER_RES_COVER);
+        lv_event_stop_processing(e);
+    }
+}
+
+void RetainedBitmap::delete_cb(lv_event_t *e) {
+    RetainedBitmap *rb = (RetainedBitmap *)lv_event_get_user_data(e);
+    if (rb->bitmap) lv_draw_buf_destroy(rb->bitmap);
+    rb->bitmap = nullptr;
+    rb->root = nullptr;
+}
+
+void RetainedBitmap::display_event_cb(lv_event_t *e) {
+    switch (lv_event_get_code(e)) {
+        case LV_EVENT_INVALIDATE_AREA: {
+            // Anything changing under, inside or over the retained area makes the bitmap stale
+            if (capturing) break;
+            const lv_area_t *inv = (const lv_area_t *)lv_event_get_param(e);
+            for (uint8_t i = 0; i < pool_count; i++) {
+                RetainedBitmap &rb = pool[i];
+                if (!rb.root || rb.stale) continue;
+                lv_area_t common;
+                if (lv_area_intersect(&common, inv, &rb.area)) rb.stale = true;
+            }
+            break;
+        }
+
+        case LV_EVENT_RENDER_START:
+            // Layout is up to date here, re-render stale subtrees before the areas are drawn
+            for (uint8_t i = 0; i < pool_count; i++) {
+                RetainedBitmap &rb = pool[i];
+                if (!rb.root || !rb.stale) continue;
+                if (lv_obj_get_screen(rb.root) != lv_screen_active()) continue;
+                if (lv_obj_has_flag(rb.root, LV_OBJ_FLAG_HIDDEN)) continue;
+                if (rb.capture()) {
+                    rb.stale = false;
+                    capture_count++;
+                    capture_total_us += rb.capture_us;
+                    frame_captured = true;
+                }
+            }
+            break;
+
+        case LV_EVENT_REFR_READY:
+            // Frames that had to re-render gain nothing, the rest saved the blitted render work
+            if (!frame_captured && frame_hit) {
+                hit_frames++;
+                saved_total_us += frame_saved_us;
+            }
+            frame_hit = false;
+            frame_captured = false;
+            frame_saved_us = 0;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void RetainedBitmap::dump() {
+    uint32_t frames = hit_frames + capture_count;
+    Serial.printf("\n=== Retained Bitmaps ===\n");
+    for (uint8_t i = 0; i < pool_count; i++) {
+        RetainedBitmap &rb = pool[i];
+        if (!rb.root) continue;
+        Serial.printf("  [%d] %ldx%ld %s, %s, last render %.2f ms\n", i,
+                      lv_area_get_width(&rb.area), lv_area_get_height(&rb.area),
+                      rb.backdrop ? "pre-composed RGB565" : "ARGB8888",
+                      rb.stale ? "stale" : "valid", rb.capture_us / 1000.0f);
+    }
+    Serial.printf("  hit rate %.1f%% (%lu blit frames, %lu re-renders, avg re-render %.2f ms)\n",
+                  frames ? hit_frames * 100.0f / frames : 0.0f, hit_frames, capture_count,
+                  capture_count ? capture_total_us / 1000.0f / capture_count : 0.0f);
+    Serial.printf("  est. render time saved: %.2f ms per hit frame, %.1f ms total\n",
+                  hit_frames ? saved_total_us / 1000.0f / hit_frames : 0.0f, saved_total_us / 1000.0f);
+}
+
+void RetainedBitmap::resetStats() {
+    hit_frames = 0;
+    capture_count = 0;
+    capture_total_us = 0;
+    saved_total_us = 0;
+}
+
+void RetainedBitmap::consoleRetained(const char *args) {
+    if (strcmp(args, "reset") == 0) {
+        resetStats();
+        Serial.println("Retained bitmap stats reset");
+    } else {
+        dump();
+    }
+}
@@ -0,0 +1,199 @@
+#include "core/scenario_bench.h"
+#include "core/touch_driver.h"
+#include "config.h"
+#include "ui.h"
+#ifndef HOMEPANEL_NATIVE
+#include "core/lvgl_heap.h"
+#endif
+
+// Static member initialization
+ScenarioBench::Result ScenarioBench::current;
+int32_t ScenarioBench::heap_before = 0;
+void (*ScenarioBench::ui_init_fn)() = ui_init;
+uint32_t ScenarioBench::frame_pixels = 0;
+DisplayDriver::FlushObserver ScenarioBench::chained_observer = nullptr;
+lv_obj_t *ScenarioBench::bench_screen = nullptr;
+
+bool ScenarioBench::runAll() {
+    static void (*const scenarios[])() = {
+        coldInit, tapTextArea, typeChars, hideKeyboard, screenChange,
+    };
+    static_assert(sizeof(scenarios) / sizeof(scenarios[0]) == sizeof(SCENARIO_BUDGETS) / sizeof(SCENARIO_BUDGETS[0]),
+                  "every scenario needs a budget");
+
+    // Pixels are counted on the flush path, whoever observed it before (mirror) still does
+    chained_observer = DisplayDriver::getFlushObserver();
+    DisplayDriver::setFlushObserver(countPixels);
+
+    Serial.println("UI scenarios (frames, ms/frame avg/max, pixels, heap delta):");
+    bool passed = true;
+    for (size_t i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        current = {};
+        heap_before = heapUsed();
+        scenarios[i]();
+        current.heap_bytes = heapUsed() - heap_before;
+        passed &= report(SCENARIO_BUDGETS[i], current);
+    }
+
+    DisplayDriver::setFlushObserver(chained_observer);
+#if SCENARIO_BUDGETS_ENFORCED
+    Serial.printf("UI scenarios: %s\n", passed ? "PASS" : "FAIL (over budget, see scenario_budgets.h)");
+    return passed;
+#else
+    Serial.printf("UI scenarios: %s (provisional budgets, gate off, see scenario_budgets.h)\n",
+                  passed ? "within budget" : "over budget");
+    return true;
+#endif
+}
+
+// Rebuild the screen from nothing and draw its first frame
+void ScenarioBench::coldInit() {
+    ui_destroy();
+    lv_obj_delete(ui____initial_actions0);
+    heap_before = heapUsed();
+
+    uint32_t start = micros();
+    ui_init_fn();
+    lv_obj_invalidate(lv_screen_active());
+    lv_refr_now(NULL);
+    uint32_t elapsed = micros() - start;
+
+    // Build time belongs to this frame, that is what a cold start costs
+    current.frames = 1;
+    current.render_us = elapsed;
+    current.max_frame_us = elapsed;
+    current.pixels = frame_pixels;
+    frame_pixels = 0;
+}
+
+// Press and release TextArea1 through the touch input device, the keyboard opens
+void ScenarioBench::tapTextArea() {
+    tap(ui_TextArea1);
+    frame();
+}
+
+// 100 keys of the on-screen keyboard into TextArea1, one frame per key
+void ScenarioBench::typeChars() {
+    // q..p on the lower-case map, the same path a key press takes in the button matrix
+    for (int i = 0; i < 100; i++) {
+        lv_buttonmatrix_set_selected_button(ui_Primary_Keyboard, 1 + i % 10);
+        lv_obj_send_event(ui_Primary_Keyboard, LV_EVENT_VALUE_CHANGED, NULL);
+        frame();
+    }
+}
+
+// The keyboard's OK key sends READY, which the SquareLine handler turns into hiding it
+void ScenarioBench::hideKeyboard() {
+    lv_obj_send_event(ui_Primary_Keyboard, LV_EVENT_READY, NULL);
+    frame();
+    lv_textarea_set_text(ui_TextArea1, "");
+    frame();
+}
+
+// Animated change to a second screen and back, the second screen is deleted afterwards
+void ScenarioBench::screenChange() {
+    _ui_screen_change(&bench_screen, LV_SCREEN_LOAD_ANIM_MOVE_LEFT, 300, 0, benchScreenInit);
+    for (uint32_t t = 0; t < 300 + 2 * LV_DEF_REFR_PERIOD; t += LV_DEF_REFR_PERIOD) step(LV_DEF_REFR_PERIOD);
+
+    _ui_screen_change(&ui_Screen1, LV_SCREEN_LOAD_ANIM_MOVE_RIGHT, 300, 0, ui_Screen1_screen_init);
+    for (uint32_t t = 0; t < 300 + 2 * LV_DEF_REFR_PERIOD; t += LV_DEF_REFR_PERIOD) step(LV_DEF_REFR_PERIOD);
+
+    lv_obj_delete(bench_screen);
+    bench_screen = nullptr;
+}
+
+// A settings-style page: a title and a column of labelled switches
+void ScenarioBench::benchScreenInit() {
+    bench_screen = lv_obj_create(NULL);
+    lv_obj_set_flex_flow(bench_screen, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_all(bench_screen, 20, 0);
+
+    lv_obj_t *title = lv_label_create(bench_screen);
+    lv_label_set_text(title, "Settings");
+
+    for (int i = 0; i < 6; i++) {
+        lv_obj_t *row = lv_obj_create(bench_screen);
+        lv_obj_set_size(row, LV_PCT(100), LV_SIZE_CONTENT);
+        lv_obj_t *label = lv_label_create(row);
+        lv_label_set_text_fmt(label, "Option %d", i + 1);
+        lv_obj_t *sw = lv_switch_create(row);
+        lv_obj_align(sw, LV_ALIGN_RIGHT_MID, 0, 0);
+        if (i % 2) lv_obj_add_state(sw, LV_STATE_CHECKED);
+    }
+}
+
+void ScenarioBench::frame() {
+    uint32_t start = micros();
+    lv_refr_now(NULL);
+    uint32_t elapsed = micros() - start;
+
+    if (frame_pixels == 0) return;
+    current.frames++;
+    current.render_us += elapsed;
+    if (elapsed > current.max_frame_us) current.max_frame_us = elapsed;
+    current.pixels += frame_pixels;
+    frame_pixels = 0;
+}
+
+void ScenarioBench::step(uint32_t ms) {
+#ifdef HOMEPANEL_NATIVE
+    DisplayDriver::advanceTick(ms);
+#else
+    delay(ms);
+#endif
+    // Timers run the animation, the refresh timer renders its frame
+    uint32_t start = micros();
+    lv_timer_handler();
+    uint32_t elapsed = micros() - start;
+
+    if (frame_pixels == 0) return;
+    current.frames++;
+    current.render_us += elapsed;
+    if (elapsed > current.max_frame_us) current.max_frame_us = elapsed;
+    current.pixels += frame_pixels;
+    frame_pixels = 0;
+}
+
+void ScenarioBench::tap(lv_obj_t *obj) {
+    lv_area_t coords;
+    lv_obj_get_coords(obj, &coords);
+    lv_indev_t *indev = lv_indev_get_next(NULL);
+
+    TouchDriver::injectTouch((coords.x1 + coords.x2) / 2, (coords.y1 + coords.y2) / 2, true);
+    lv_indev_read(indev);
+    TouchDriver::injectTouch((coords.x1 + coords.x2) / 2, (coords.y1 + coords.y2) / 2, false);
+    lv_indev_read(indev);
+}
+
+int32_t ScenarioBench::heapUsed() {
+#ifdef HOMEPANEL_NATIVE
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return (int32_t)(mon.total_size - mon.free_size);
+#else
+    return (int32_t)LvglHeap::usedBytes();
+#endif
+}
+
+bool ScenarioBench::report(const ScenarioBudget &budget, const Result &r) {
+    float ms_per_frame = r.frames ? r.render_us / 1000.0f / r.frames : 0.0f;
+    bool ms_ok = ms_per_frame <= budget.ms_per_frame;
+    bool px_ok = r.pixels <= budget.pixels;
+    bool heap_ok = r.heap_bytes <= budget.heap_bytes;
+    bool ok = ms_ok && px_ok && heap_ok;
+
+    Serial.printf("  %-16s %4u frames, %7.2f%s / %7.2f ms, %8u px%s, heap %+7d%s  %s\n",
+                  budget.name, (unsigned)r.frames, ms_per_frame, ms_ok ? "" : "!", r.max_frame_us / 1000.0f,
+                  (unsigned)r.pixels, px_ok ? "" : "!", (int)r.heap_bytes, heap_ok ? "" : "!",
+                  ok ? "ok" : "OVER BUDGET");
+    if (!ok) {
+        Serial.printf("  %-16s budget %.2f ms/frame, %u px, %+d heap\n", "",
+                      budget.ms_per_frame, (unsigned)budget.pixels, (int)budget.heap_bytes);
+    }
+    return ok;
+}
+
+void ScenarioBench::countPixels(const lv_area_t *area, const uint16_t *px, uint32_t stride) {
+    frame_pixels += lv_area_get_size(area);
+    if (chained_observer) chained_observer(area, px, stride);
+}
@@ -0,0 +1,301 @@
+#include "core/screenshot_server.h"
+#include "core/lvgl_lock.h"
+#include <esp_heap_caps.h>
+#include <esp_rom_crc.h>
+#include <Arduino.h>
+
+// Static member initialization
+DisplayDriver *ScreenshotServer::display = nullptr;
+WebServer *ScreenshotServer::server = nullptr;
+uint16_t *ScreenshotServer::stripe = nullptr;
+uint8_t ScreenshotServer::out[SCREENSHOT_CHUNK_SIZE];
+size_t ScreenshotServer::out_len = 0;
+uint32_t ScreenshotServer::lock_max_us = 0;
+
+// The framebuffer holds byte-swapped RGB565
+static inline void rgb565_swapped_to_rgb888(uint16_t px, uint8_t *rgb) {
+    uint16_t c = (px << 8) | (px >> 8);
+    uint8_t r = (c >> 11) & 0x1F;
+    uint8_t g = (c >> 5) & 0x3F;
+    uint8_t b = c & 0x1F;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+static inline void put_be32(uint8_t *p, uint32_t v) {
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+void ScreenshotServer::init(DisplayDriver *driver) {
+    display = driver;
+    server = new WebServer(SCREENSHOT_PORT);
+    server->on("/screenshot.png", HTTP_GET, handlePng);
+    server->on("/screenshot.qoi", HTTP_GET, handleQoi);
+    server->begin();
+
+    xTaskCreatePinnedToCore(task, "screenshot", 6144, NULL, 1, NULL, SCREENSHOT_TASK_CORE);
+    Serial.printf("ScreenshotServer: Listening on port %d (/screenshot.png, /screenshot.qoi)\n", SCREENSHOT_PORT);
+}
+
+void ScreenshotServer::task(void *param) {
+    while (true) {
+        server->handleClient();
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+}
+
+bool ScreenshotServer::beginCapture(const char *content_type) {
+    // One stripe in internal SRAM, only for the duration of the request
+    stripe = (uint16_t *)heap_caps_malloc(SCREEN_WIDTH * SCREENSHOT_STRIPE_LINES * sizeof(uint16_t),
+                                          MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!stripe || !display->getLCD()->_panel_instance.getFrameBuffer()) {
+        heap_caps_free(stripe);
+        stripe = nullptr;
+        server->send(503, "text/plain", "Screenshot unavailable\n");
+        return false;
+    }
+
+    out_len = 0;
+    lock_max_us = 0;
+    server->sendHeader("Cache-Control", "no-store");
+    server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server->send(200, content_type, "");
+    return true;
+}
+
+void ScreenshotServer::endCapture(const char *format, uint32_t start_ms) {
+    flushOut();
+    server->sendContent("", 0);  // Terminating chunk
+
+    heap_caps_free(stripe);
+    stripe = nullptr;
+
+    Serial.printf("ScreenshotServer: %s sent in %lu ms, longest UI lock %lu us\n",
+                  format, millis() - start_ms, lock_max_us);
+}
+
+// Snapshot a few framebuffer lines while LVGL is not drawing, encoding happens unlocked
+void ScreenshotServer::copyStripe(uint32_t y, uint32_t lines) {
+    const uint16_t *fb = display->getLCD()->_panel_instance.getFrameBuffer();
+    LvglLock lock;
+    uint32_t start = micros();
+    memcpy(stripe, fb + y * SCREEN_WIDTH, SCREEN_WIDTH * lines * sizeof(uint16_t));
+    uint32_t held = micros() - start;
+    if (held > lock_max_us) lock_max_us = held;
+}
+
+void ScreenshotServer::put(const void *data, size_t len) {
+    const uint8_t *p = (const uint8_t *)data;
+    while (len > 0) {
+        size_t n = sizeof(out) - out_len;
+        if (n > len) n = len;
+        memcpy(out + out_len, p, n);
+        out_len += n;
+        p += n;
+        len -= n;
+        if (out_len == sizeof(out)) flushOut();
+    }
+}
+
+void ScreenshotServer::flushOut() {
+    if (out_len == 0) return;
+    server->sendContent((const char *)out, out_len);
+    out_len = 0;
+}
+
+// PNG with one IDAT chunk per row, each holding a stored (uncompressed) deflate block
+// Bigger than QOI but every browser shows it and it costs next to no CPU
+void ScreenshotServer::handlePng() {
+    uint32_t start_ms = millis();
+    if (!beginCapture("image/png")) return;
+
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    put(signature, sizeof(signature));
+
+    uint8_t ihdr[4 + 4 + 13 + 4];
+    put_be32(ihdr, 13);
+    memcpy(ihdr + 4, "IHDR", 4);
+    put_be32(ihdr + 8, SCREEN_WIDTH);
+    put_be32(ihdr + 12, SCREEN_HEIGHT);
+    ihdr[16] = 8;   // Bit depth
+    ihdr[17] = 2;   // Truecolor RGB
+    ihdr[18] = 0;   // Deflate
+    ihdr[19] = 0;   // Adaptive filtering
+    ihdr[20] = 0;   // No interlace
+    put_be32(ihdr + 21, esp_rom_crc32_le(0, ihdr + 4, 4 + 13));
+    put(ihdr, sizeof(ihdr));
+
+    // IDAT data per row: [zlib header] + stored block header + filter byte + RGB + [adler32]
+    static const uint32_t row_bytes = 1 + SCREEN_WIDTH * 3;
+    uint8_t *row = (uint8_t *)malloc(4 + 4 + 2 + 5 + row_bytes + 4 + 4);
+    if (!row) {
+        endCapture("png (out of memory)", start_ms);
+        return;
+    }
+
+    uint32_t adler_a = 1, adler_b = 0;
+    for (uint32_t y0 = 0; y0 < SCREEN_HEIGHT; y0 += SCREENSHOT_STRIPE_LINES) {
+        uint32_t lines = SCREEN_HEIGHT - y0 < SCREENSHOT_STRIPE_LINES ? SCREEN_HEIGHT - y0 : SCREENSHOT_STRIPE_LINES;
+        copyStripe(y0, lines);
+
+        for (uint32_t l = 0; l < lines; l++) {
+            uint32_t y = y0 + l;
+            bool first = y == 0;
+            bool last = y == SCREEN_HEIGHT - 1;
+
+            uint8_t *p = row + 8;
+            if (first) {
+                *p++ = 0x78;  // zlib header, 32K window, no compression
+                *p++ = 0x01;
+            }
+            *p++ = last ? 1 : 0;  // BFINAL, BTYPE = stored
+            *p++ = row_bytes & 0xFF;
+            *p++ = row_bytes >> 8;
+            *p++ = ~row_bytes & 0xFF;
+            *p++ = (~row_bytes >> 8) & 0xFF;
+
+            uint8_t *raw = p;
+            *p++ = 0;  // Filter type None
+            const uint16_t *src = stripe + l * SCREEN_WIDTH;
+            for (uint32_t x = 0; x < SCREEN_WIDTH; x++, p += 3) {
+                rgb565_swapped_to_rgb888(src[x], p);
+            }
+
+            // Adler-32 over the uncompressed stream (5552 is the largest safe run before modulo)
+            for (uint32_t i = 0; i < row_bytes; ) {
+                uint32_t n = row_bytes - i < 5552 ? row_bytes - i : 5552;
+                for (uint32_t k = 0; k < n; k++) {
+                    adler_a += raw[i + k];
+                    adler_b += adler_a;
+                }
+                adler_a %= 65521;
+                adler_b %= 65521;
+                i += n;
+            }
+            if (last) {
+                put_be32(p, (adler_b << 16) | adler_a);
+                p += 4;
+            }
+
+            uint32_t data_len = p - (row + 8);
+            put_be32(row, data_len);
+            memcpy(row + 4, "IDAT", 4);
+            put_be32(p, esp_rom_crc32_le(0, row + 4, 4 + data_len));
+            put(row, 8 + data_len + 4);
+        }
+    }
+    free(row);
+
+    static const uint8_t iend[12] = { 0, 0, 0, 0, 'I', 'E', 'N', 'D', 0xAE, 0x42, 0x60, 0x82 };
+    put(iend, sizeof(iend));
+
+    endCapture("png", start_ms);
+}
+
+// QOI (https://qoiformat.org), streaming encoder with the state kept across stripes
+void ScreenshotServer::handleQoi() {
+    uint32_t start_ms = millis();
+    if (!beginCapture("image/qoi")) return;
+
+    uint8_t header[14] = { 'q', 'o', 'i', 'f' };
+    put_be32(header + 4, SCREEN_WIDTH);
+    put_be32(header + 8, SCREEN_HEIGHT);
+    header[12] = 3;  // RGB
+    header[13] = 0;  // sRGB
+    put(header, sizeof(header));
+
+    uint32_t index[64] = { 0 };     // Seen pixels as 0xRRGGBB with alpha implied 255
+    bool index_valid[64] = { false };
+    uint8_t prev[3] = { 0, 0, 0 };
+    uint32_t prev_packed = 0;
+    uint8_t run = 0;
+
+    for (uint32_t y0 = 0; y0 < SCREEN_HEIGHT; y0 += SCREENSHOT_STRIPE_LINES) {
+        uint32_t lines = SCREEN_HEIGHT - y0 < SCREENSHOT_STRIPE_LINES ? SCREEN_HEIGHT - y0 : SCREENSHOT_STRIPE_LINES;
+        copyStripe(y0, lines);
+
+        const uint16_t *src = stripe;
+        uint32_t count = lines * SCREEN_WIDTH;
+        uint16_t last_raw = 0;
+        bool have_last = false;
+
+        for (uint32_t i = 0; i < count; i++) {
+            // Runs of identical framebuffer pixels skip the color conversion entirely
+            if (have_last && src[i] == last_raw) {
+                run++;
+                if (run == 62) {
+                    uint8_t op = 0xC0 | (run - 1);
+                    put(&op, 1);
+                    run = 0;
+                }
+                continue;
+            }
+
+            uint8_t px[3];
+            rgb565_swapped_to_rgb888(src[i], px);
+            uint32_t packed = (px[0] << 16) | (px[1] << 8) | px[2];
+            last_raw = src[i];
+            have_last = true;
+
+            if (packed == prev_packed) {
+                run++;
+                if (run == 62) {
+                    uint8_t op = 0xC0 | (run - 1);
+                    put(&op, 1);
+                    run = 0;
+                }
+                continue;
+            }
+
+            if (run > 0) {
+                uint8_t op = 0xC0 | (run - 1);
+                put(&op, 1);
+                run = 0;
+            }
+
+            uint8_t h = (px[0] * 3 + px[1] * 5 + px[2] * 7 + 255 * 11) % 64;
+            if (index_valid[h] && index[h] == packed) {
+                put(&h, 1);
+            } else {
+                index[h] = packed;
+                index_valid[h] = true;
+
+                int8_t vr = px[0] - prev[0];
+                int8_t vg = px[1] - prev[1];
+                int8_t vb = px[2] - prev[2];
+                int8_t vg_r = vr - vg;
+                int8_t vg_b = vb - vg;
+
+                if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2) {
+                    uint8_t op = 0x40 | ((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2);
+                    put(&op, 1);
+                } else if (vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 && vg_b > -9 && vg_b < 8) {
+                    uint8_t op[2] = { (uint8_t)(0x80 | (vg + 32)), (uint8_t)(((vg_r + 8) << 4) | (vg_b + 8)) };
+                    put(op, 2);
+                } else {
+                    uint8_t op[4] = { 0xFE, px[0], px[1], px[2] };
+                    put(op, 4);
+                }
+            }
+
+            prev[0] = px[0];
+            prev[1] = px[1];
+            prev[2] = px[2];
+            prev_packed = packed;
+        }
+    }
+
+    if (run > 0) {
+        uint8_t op = 0xC0 | (run - 1);
+        put(&op, 1);
+    }
+
+    static const uint8_t end_marker[8] = { 0, 0, 0, 0, 0, 0, 0, 1 };
+    put(end_marker, sizeof(end_marker));
+
+    endCapture("qoi", start_ms);
+}
@@ -0,0 +1,66 @@
+#include "core/serial_console.h"
+#include "core/lvgl_lock.h"
+#include <Arduino.h>
+
+// Static member initialization
+SerialConsole::Command SerialConsole::commands[CONSOLE_MAX_COMMANDS];
+uint8_t SerialConsole::command_count = 0;
+
+void SerialConsole::start() {
+    registerCommand("help", "List commands", printHelp);
+    xTaskCreatePinnedToCore(task, "console", 4096, NULL, 1, NULL, CONSOLE_TASK_CORE);
+}
+
+bool SerialConsole::registerCommand(const char *name, const char *help, Handler handler) {
+    if (command_count >= CONSOLE_MAX_COMMANDS) {
+        Serial.printf("SerialConsole: command table full, '%s' not registered\n", name);
+        return false;
+    }
+    commands[command_count++] = { name, help, handler };
+    return true;
+}
+
+void SerialConsole::task(void *param) {
+    char line[CONSOLE_LINE_LENGTH];
+    size_t len = 0;
+
+    while (true) {
+        while (Serial.available()) {
+            char c = (char)Serial.read();
+            if (c == '\r' || c == '\n') {
+                if (len > 0) {
+                    line[len] = '\0';
+                    execute(line);
+                    len = 0;
+                }
+            } else if (len < sizeof(line) - 1) {
+                line[len++] = c;
+            }
+        }
+        vTaskDelay(pdMS_TO_TICKS(50));
+    }
+}
+
+void SerialConsole::execute(char *line) {
+    // Split "name args..."
+    char *args = line;
+    while (*args && *args != ' ') args++;
+    if (*args) *args++ = '\0';
+    while (*args == ' ') args++;
+
+    for (uint8_t i = 0; i < command_count; i++) {
+        if (strcmp(commands[i].name, line) == 0) {
+            LvglLock lock;
+            commands[i].handler(args);
+            return;
+        }
+    }
+    Serial.printf("Unknown command '%s', type 'help'\n", line);
+}
+
+void SerialConsole::printHelp(const char *args) {
+    Serial.println("Commands:");
+    for (uint8_t i = 0; i < command_count; i++) {
+        Serial.printf("  %-10s %s\n", commands[i].name, commands[i].help);
+    }
+}
@@ -3,6 +3,12 @@
 #include "core/touch_driver.h"
 #include "core/power_manager.h"
 #include "core/display_driver.h"
+#include "core/ui_task.h"
+#include "core/serial_console.h"
+#include "core/touch_latency.h"
+#include "core/i2c_bus.h"
+#include "core/dynamic_power.h"
+#include "core/lvgl_lock.h"
 
 // Static touch point data
 static struct {
@@ -12,8 +18,63 @@ static struct {
     bool was_pressed;  // Track previous state for edge detection
 } touchPoint = {0, 0, false, false};
 
+// Latest GT911 report, written by the poll on the I2C bus task, taken by the read callback
+static TouchPoint report_points[TOUCH_MAX_POINTS];
+static uint8_t report_count = 0;
+static bool report_fresh = false;  // Not taken by the read callback yet
+static portMUX_TYPE report_mux = portMUX_INITIALIZER_UNLOCKED;
+
+// All points from the last GT911 report, as seen by the read callback
+static TouchPoint gt911_points[TOUCH_MAX_POINTS];
+static uint8_t gt911_count = 0;
+
+// Gestures on top of the points, delivered as gesture_event to the object under the fingers
+static GestureRecognizer recognizer;
+static lv_event_code_t gesture_event = LV_EVENT_ALL;
+static int16_t frozen_x = 0;  // Where the LVGL pointer stays while two fingers are down
+static int16_t frozen_y = 0;
+
+// Smoothing and prediction of the LVGL pointer
+static TouchFilter filter;
+static bool filter_enabled = TOUCH_FILTER_ENABLED;
+static bool filter_trace = false;  // Print raw samples for tools/touch_replay.sh
+static int16_t filtered_x = 0;
+static int16_t filtered_y = 0;
+
+// Remote touch state (written by the mirror task, read by the UI task)
+static struct {
+    uint16_t x;
+    uint16_t y;
+    bool pressed;
+    bool latched;  // A press that was released again before the next read still counts once
+} remotePoint = {0, 0, false, false};
+static portMUX_TYPE remote_mux = portMUX_INITIALIZER_UNLOCKED;
+
 // Static LCD instance pointer (set during init)
 static LGFX *lcd_instance = nullptr;
+static lv_indev_t *touch_indev = nullptr;
+
+// GT911 bus parameters, taken from the LovyanGFX touch config
+static int gt911_addr = GT911_ADDR;
+static uint32_t gt911_freq = 400000;
+
+// Set by a new GT911 report or a remote touch, makes the UI task read the input device right away
+static volatile bool read_pending = false;
+static volatile bool int_pending = false;  // INT fired since the last poll
+static uint32_t last_touch_ms = 0;
+static uint32_t read_period_ms = TOUCH_ACTIVE_POLL_MS;
+
+// I2C traffic, split by whether the panel was idle or in use when the poll ran
+static struct {
+    uint32_t idle_txn;
+    uint32_t idle_ms;
+    uint32_t active_txn;
+    uint32_t active_ms;
+    uint32_t status_reads;  // 1-byte buffer status checks
+    uint32_t full_reads;    // Burst read of status + all points, then a status clear
+    uint32_t gated;         // Reads that stopped at the status check
+    uint32_t last_ms;
+} i2c_stats = {};
 
 // Constructor
 TouchDriver::TouchDriver() : indev(nullptr) {
@@ -30,45 +91,341 @@ bool TouchDriver::init(LGFX *lcd) {
     Serial.println("Touch Controller: GT911 initialized by LovyanGFX");
     
     // Register touch controller with LVGL
-    // The my_touchpad_read callback will call LovyanGFX's getTouch() method
+    // The GT911 is read on the I2C bus task (pollGt911), my_touchpad_read only takes the result
     indev = lv_indev_create();
     lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
     lv_indev_set_read_cb(indev, my_touchpad_read);
+    touch_indev = indev;
+    gesture_event = (lv_event_code_t)lv_event_register_id();
+    
+    // Status checks and point reads go to the GT911 on the bus LovyanGFX set up
+    auto cfg = lcd->_touch_instance.config();
+    gt911_addr = cfg.i2c_addr;
+    gt911_freq = cfg.freq;
+    
+#if TOUCH_INT >= 0
+    // GT911 pulses INT low when it has a new report, reads only happen after that
+    pinMode(TOUCH_INT, INPUT);
+    attachInterrupt(TOUCH_INT, touch_isr, FALLING);
+    Serial.printf("Touch reads gated by INT on GPIO %d\n", TOUCH_INT);
+#else
+    Serial.printf("Touch reads gated by GT911 status register, idle poll %d ms\n", TOUCH_IDLE_POLL_MS);
+#endif
+    i2c_stats.last_ms = millis();
+    
+    I2cBus::setTouchPoller(pollGt911, read_period_ms);
+    
+    SerialConsole::registerCommand("touch", "Touch I2C traffic: touch [reset]", consoleTouch);
+    SerialConsole::registerCommand("filter", "Touch filter: filter [on|off|trace|predict <ms>|predict auto]", consoleFilter);
     
     Serial.println("Touch driver registered with LVGL");
     return true;
 }
 
-// LVGL touchpad read callback
+// GT911 poll, runs on the I2C bus task every read period or when INT fires
+void TouchDriver::pollGt911() {
+    uint32_t now = millis();
+    bool finger_down = report_count > 0;
+    bool active = finger_down || now - last_touch_ms < TOUCH_IDLE_AFTER_MS;
+    uint32_t txn = 0;
+    
+    // Only read the points when the GT911 has a report (or a finger is down, to see it lift)
+    bool ready = finger_down;
+#if TOUCH_INT >= 0
+    ready = ready || int_pending;
+    int_pending = false;
+#else
+    if (!ready) {
+        ready = gt911BufferReady();
+        txn++;
+    }
+#endif
+    
+    if (ready) {
+        TouchPoint points[TOUCH_MAX_POINTS];
+        int n = gt911ReadPoints(points);
+        i2c_stats.full_reads++;
+        txn += 1;
+        if (n >= 0) {
+            txn += 1;  // Status clear
+            portENTER_CRITICAL(&report_mux);
+            memcpy(report_points, points, n * sizeof(TouchPoint));
+            report_count = n;
+            report_fresh = true;
+            portEXIT_CRITICAL(&report_mux);
+            
+            // Get the UI task to read the input device now rather than at its next timer
+            read_pending = true;
+            UiTask::notify();
+        }
+    } else {
+        i2c_stats.gated++;
+    }
+    
+    if (active) {
+        i2c_stats.active_txn += txn;
+        i2c_stats.active_ms += now - i2c_stats.last_ms;
+    } else {
+        i2c_stats.idle_txn += txn;
+        i2c_stats.idle_ms += now - i2c_stats.last_ms;
+    }
+    i2c_stats.last_ms = now;
+}
+
+// LVGL touchpad read callback, takes the latest report without touching the bus
 void TouchDriver::my_touchpad_read(lv_indev_t *indev, lv_indev_data_t *data) {
     if (!lcd_instance) {
         data->state = LV_INDEV_STATE_RELEASED;
         return;
     }
     
-    uint16_t x, y;
+    uint32_t now = millis();
+    read_pending = false;
+    
+    bool fresh;  // A new sample for the filter, not the last report again
+    portENTER_CRITICAL(&report_mux);
+    fresh = report_fresh;
+    report_fresh = false;
+    gt911_count = report_count;
+    memcpy(gt911_points, report_points, report_count * sizeof(TouchPoint));
+    portEXIT_CRITICAL(&report_mux);
     
-    // Use LovyanGFX's getTouch() method
-    if (lcd_instance->getTouch(&x, &y)) {
-        touchPoint.x = x;
-        touchPoint.y = y;
+    // The recognizer sees every point, LVGL gets the first one as its pointer
+    TouchPoint remote;
+    const TouchPoint *points = gt911_points;
+    uint8_t count = gt911_count;
+    if (count > 0) {
+        touchPoint.x = gt911_points[0].x;
+        touchPoint.y = gt911_points[0].y;
         touchPoint.pressed = true;
     } else {
-        touchPoint.pressed = false;
+        // Fall back to a remote touch, if any
+        portENTER_CRITICAL(&remote_mux);
+        touchPoint.x = remotePoint.x;
+        touchPoint.y = remotePoint.y;
+        touchPoint.pressed = remotePoint.pressed || remotePoint.latched;
+        remotePoint.latched = false;
+        portEXIT_CRITICAL(&remote_mux);
+        
+        remote = { 0, (int16_t)touchPoint.x, (int16_t)touchPoint.y };
+        points = &remote;
+        count = touchPoint.pressed ? 1 : 0;
+        fresh = true;
+    }
+    
+    // Smooth and extrapolate the pointer, gestures work on the raw points
+    if (touchPoint.pressed && !touchPoint.was_pressed) filter.reset();
+    if (touchPoint.pressed && fresh) {
+        if (filter_trace) Serial.printf("touch,%lu,%u,%u,1\n", now, touchPoint.x, touchPoint.y);
+        if (filter_enabled) {
+            filter.update(touchPoint.x, touchPoint.y, now, &filtered_x, &filtered_y);
+        } else {
+            filtered_x = touchPoint.x;
+            filtered_y = touchPoint.y;
+        }
+    } else if (!touchPoint.pressed && touchPoint.was_pressed && filter_trace) {
+        Serial.printf("touch,%lu,%u,%u,0\n", now, touchPoint.x, touchPoint.y);
     }
     
+    Gesture gestures[GestureRecognizer::MAX_OUT];
+    bool was_multi = recognizer.isMultiTouch();
+    uint8_t n_gestures = recognizer.update(points, count, now, gestures);
+    if (recognizer.isMultiTouch() && !was_multi) {
+        frozen_x = filtered_x;
+        frozen_y = filtered_y;
+        // Drop the press LVGL is tracking, lifting the fingers must not click what is underneath
+        lv_indev_reset(indev, NULL);
+        lv_indev_wait_release(indev);
+    }
+    
+    // Fast reads while in use, slow status-only checks once the panel has been left alone
+    if (touchPoint.pressed) last_touch_ms = now;
+    bool now_active = touchPoint.pressed || now - last_touch_ms < TOUCH_IDLE_AFTER_MS;
+    uint32_t period = now_active ? TOUCH_ACTIVE_POLL_MS : (TOUCH_INT >= 0 ? TOUCH_INT_IDLE_POLL_MS : TOUCH_IDLE_POLL_MS);
+    if (period != read_period_ms) {
+        read_period_ms = period;
+        lv_timer_set_period(lv_indev_get_read_timer(indev), period);
+        I2cBus::setTouchPeriod(period);
+    }
+    // Touch burst: polls and the passes they trigger run at full frequency
+    DynamicPower::setTouchActive(now_active);
+    
     // Detect touch press edge (transition from not pressed to pressed)
     if (touchPoint.pressed && !touchPoint.was_pressed) {
         // Notify power manager of user activity
         PowerManager::onUserActivity();
+        TouchLatency::touchSample();
     }
     touchPoint.was_pressed = touchPoint.pressed;
     
     if (touchPoint.pressed) {
         data->state = LV_INDEV_STATE_PRESSED;
-        data->point.x = touchPoint.x;
-        data->point.y = touchPoint.y;
+        // Hold the pointer still during two-finger gestures so nothing underneath scrolls
+        bool multi = recognizer.isMultiTouch();
+        data->point.x = multi ? frozen_x : filtered_x;
+        data->point.y = multi ? frozen_y : filtered_y;
     } else {
         data->state = LV_INDEV_STATE_RELEASED;
     }
+    
+    for (uint8_t i = 0; i < n_gestures; i++) {
+        dispatchGesture(gestures[i]);
+    }
+}
+
+// Burst read of the status byte and all point records, then clear the status so the GT911
+// can post the next report. Returns the number of points, or -1 when no new report is waiting
+int TouchDriver::gt911ReadPoints(TouchPoint *points) {
+    const uint8_t reg[2] = { GT911_POINT_INFO >> 8, GT911_POINT_INFO & 0xFF };
+    uint8_t buf[1 + TOUCH_MAX_POINTS * 8];
+    if (!I2cBus::writeRead(gt911_addr, reg, 2, buf, sizeof(buf), gt911_freq)) {
+        return -1;
+    }
+    uint8_t status = buf[0];
+    if (!(status & 0x80)) {
+        return -1;
+    }
+    
+    // Point records from GT911_POINT_1: track id, x, y, size (16-bit LE), reserved
+    // The touch config maps 1:1 onto the panel (no rotation, 0..799 / 0..479), so raw
+    // coordinates are used as they are
+    int count = status & 0x0F;
+    if (count > TOUCH_MAX_POINTS) count = TOUCH_MAX_POINTS;
+    for (int i = 0; i < count; i++) {
+        const uint8_t *p = &buf[1 + i * 8];
+        int16_t x = p[1] | (p[2] << 8);
+        int16_t y = p[3] | (p[4] << 8);
+        points[i].id = p[0];
+        points[i].x = x < SCREEN_WIDTH ? x : SCREEN_WIDTH - 1;
+        points[i].y = y < SCREEN_HEIGHT ? y : SCREEN_HEIGHT - 1;
+    }
+    
+    const uint8_t clear[3] = { GT911_POINT_INFO >> 8, GT911_POINT_INFO & 0xFF, 0 };
+    I2cBus::write(gt911_addr, clear, 3, gt911_freq);
+    return count;
+}
+
+// The object under the gesture start gets the event (and its parents, if it bubbles), the
+// active screen always gets it too so page swipes can be handled in one place
+void TouchDriver::dispatchGesture(const Gesture &gesture) {
+    lv_obj_t *screen = lv_screen_active();
+    if (!screen) return;
+    
+    lv_point_t start = { gesture.start_x, gesture.start_y };
+    lv_obj_t *target = gesture.type == Gesture::EDGE_SWIPE ? nullptr : lv_indev_search_obj(screen, &start);
+    
+    lv_obj_t *obj = target;
+    while (obj && obj != screen && lv_obj_has_flag(obj, LV_OBJ_FLAG_EVENT_BUBBLE)) {
+        obj = lv_obj_get_parent(obj);
+    }
+    bool reaches_screen = obj == screen;
+    
+    if (target && lv_obj_send_event(target, gesture_event, (void *)&gesture) != LV_RESULT_OK) {
+        return;  // Target deleted by its handler
+    }
+    if (!reaches_screen) {
+        lv_obj_send_event(lv_screen_active(), gesture_event, (void *)&gesture);
+    }
+}
+
+lv_event_code_t TouchDriver::getGestureEvent() {
+    return gesture_event;
+}
+
+// Remote touch injection
+void TouchDriver::injectTouch(int16_t x, int16_t y, bool pressed) {
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x >= SCREEN_WIDTH) x = SCREEN_WIDTH - 1;
+    if (y >= SCREEN_HEIGHT) y = SCREEN_HEIGHT - 1;
+    
+    portENTER_CRITICAL(&remote_mux);
+    remotePoint.x = x;
+    remotePoint.y = y;
+    remotePoint.pressed = pressed;
+    if (pressed) remotePoint.latched = true;
+    portEXIT_CRITICAL(&remote_mux);
+    
+    // Get the UI task to read the input device now rather than at its next timer
+    read_pending = true;
+    UiTask::notify();
+}
+
+void TouchDriver::serviceReadRequest() {
+    if (read_pending && touch_indev) {
+        // Writes LVGL's timer list: already held by the UI pass, recursive, so this costs little
+        LvglLock lock;
+        lv_timer_ready(lv_indev_get_read_timer(touch_indev));
+    }
+}
+
+void IRAM_ATTR TouchDriver::touch_isr() {
+    DynamicPower::touchInterruptFromISR();
+    int_pending = true;
+    I2cBus::kickTouchFromISR();
+}
+
+// One write-read of the buffer status register, bit 7 is set when a new report is waiting
+bool TouchDriver::gt911BufferReady() {
+    const uint8_t reg[2] = { GT911_POINT_INFO >> 8, GT911_POINT_INFO & 0xFF };
+    uint8_t status = 0;
+    i2c_stats.status_reads++;
+    if (!I2cBus::writeRead(gt911_addr, reg, 2, &status, 1, gt911_freq)) {
+        return true;  // Let the full read deal with a bus error rather than dropping a touch
+    }
+    return status & 0x80;
+}
+
+void TouchDriver::dumpStats() {
+    uint32_t idle_ms = i2c_stats.idle_ms;
+    uint32_t active_ms = i2c_stats.active_ms;
+    Serial.println("\n=== Touch I2C ===");
+    Serial.printf("  idle:   %lu transactions in %.1f s (%.1f/s)\n", i2c_stats.idle_txn, idle_ms / 1000.0f,
+                  idle_ms ? i2c_stats.idle_txn * 1000.0f / idle_ms : 0.0f);
+    Serial.printf("  active: %lu transactions in %.1f s (%.1f/s)\n", i2c_stats.active_txn, active_ms / 1000.0f,
+                  active_ms ? i2c_stats.active_txn * 1000.0f / active_ms : 0.0f);
+    Serial.printf("  %lu status checks, %lu full reads, %lu reads gated, poll period %lu ms\n",
+                  i2c_stats.status_reads, i2c_stats.full_reads, i2c_stats.gated, read_period_ms);
+}
+
+void TouchDriver::resetStats() {
+    uint32_t now = millis();
+    i2c_stats = {};
+    i2c_stats.last_ms = now;
+}
+
+void TouchDriver::consoleTouch(const char *args) {
+    if (strcmp(args, "reset") == 0) {
+        resetStats();
+        Serial.println("Touch stats reset");
+    } else {
+        dumpStats();
+    }
+}
+
+void TouchDriver::consoleFilter(const char *args) {
+    TouchFilter::Params p = filter.getParams();
+    if (strcmp(args, "on") == 0 || strcmp(args, "off") == 0) {
+        filter_enabled = strcmp(args, "on") == 0;
+    } else if (strcmp(args, "trace") == 0) {
+        filter_trace = !filter_trace;
+    } else if (strcmp(args, "predict auto") == 0) {
+        // Extrapolate over the measured touch-to-photon time
+        uint32_t median_us = TouchLatency::totalMedianUs();
+        if (median_us == 0) {
+            Serial.println("Filter: no latency measured yet, tap around and check 'latency' first");
+            return;
+        }
+        p.predict_ms = (median_us + 500) / 1000;
+        filter.setParams(p);
+    } else if (strncmp(args, "predict ", 8) == 0) {
+        p.predict_ms = strtoul(args + 8, NULL, 10);
+        filter.setParams(p);
+    } else if (args[0]) {
+        Serial.println("Usage: filter [on|off|trace|predict <ms>|predict auto]");
+        return;
+    }
+    Serial.printf("Filter: %s, min cutoff %.2f Hz, beta %.3f, dcutoff %.2f Hz, predict %u ms (max %u px), trace %s\n",
+                  filter_enabled ? "on" : "off", p.min_cutoff_mhz / 1000.0f, p.beta_x1000 / 1000.0f,
+                  p.dcutoff_mhz / 1000.0f, p.predict_ms, p.predict_max_px, filter_trace ? "on" : "off");
 }
@@ -0,0 +1,68 @@
+#include "core/touch_filter.h"
+#include <stdlib.h>
+
+TouchFilter::Params TouchFilter::defaults() {
+    Params p;
+    p.min_cutoff_mhz = TOUCH_FILTER_MIN_CUTOFF_MHZ;
+    p.beta_x1000 = TOUCH_FILTER_BETA_X1000;
+    p.dcutoff_mhz = TOUCH_FILTER_DCUTOFF_MHZ;
+    p.predict_ms = TOUCH_PREDICT_MS;
+    p.predict_max_px = TOUCH_PREDICT_MAX_PX;
+    return p;
+}
+
+void TouchFilter::reset() {
+    ax = {0, 0, 0};
+    ay = {0, 0, 0};
+    last_ms = 0;
+    primed = false;
+}
+
+void TouchFilter::update(int16_t x, int16_t y, uint32_t t_ms, int16_t *out_x, int16_t *out_y) {
+    if (!primed) {
+        ax = { x << 4, 0, x };
+        ay = { y << 4, 0, y };
+        last_ms = t_ms;
+        primed = true;
+        *out_x = x;
+        *out_y = y;
+        return;
+    }
+
+    uint32_t dt = t_ms - last_ms;
+    if (dt == 0) dt = 1;
+    last_ms = t_ms;
+
+    *out_x = step(ax, x, dt, SCREEN_WIDTH - 1);
+    *out_y = step(ay, y, dt, SCREEN_HEIGHT - 1);
+}
+
+// Smoothing factor of a first-order low-pass: r / (1 + r) with r = 2 pi fc dt, in Q16
+int32_t TouchFilter::alphaQ16(uint32_t cutoff_mhz, uint32_t dt_ms) {
+    int64_t r = (int64_t)6283 * cutoff_mhz * dt_ms;  // 2 pi fc dt, scaled by 1e9
+    return (int32_t)((r << 16) / (r + 1000000000LL));
+}
+
+int16_t TouchFilter::step(Axis &a, int16_t raw, uint32_t dt_ms, int16_t limit) const {
+    int32_t raw_q4 = raw << 4;
+
+    // Velocity from consecutive raw samples, then smoothed
+    int32_t vel = (int32_t)((int64_t)(raw - a.last_raw) * 16000 / (int32_t)dt_ms);
+    a.last_raw = raw;
+    a.vel_q4 += (int32_t)((int64_t)(vel - a.vel_q4) * alphaQ16(params.dcutoff_mhz, dt_ms) >> 16);
+
+    // Faster finger, higher cutoff, less lag
+    uint32_t speed = abs(a.vel_q4) >> 4;
+    uint32_t cutoff = params.min_cutoff_mhz + params.beta_x1000 * speed;
+    a.pos_q4 += (int32_t)((int64_t)(raw_q4 - a.pos_q4) * alphaQ16(cutoff, dt_ms) >> 16);
+
+    int32_t ahead = (int32_t)((int64_t)a.vel_q4 * params.predict_ms / 1000);
+    int32_t max_q4 = params.predict_max_px << 4;
+    if (ahead > max_q4) ahead = max_q4;
+    if (ahead < -max_q4) ahead = -max_q4;
+
+    int32_t out = (a.pos_q4 + ahead + 8) >> 4;
+    if (out < 0) out = 0;
+    if (out > limit) out = limit;
+    return (int16_t)out;
+}
@@ -0,0 +1,131 @@
+#include "core/touch_latency.h"
+#include "core/serial_console.h"
+#include <esp_timer.h>
+
+// Static member initialization
+volatile TouchLatency::State TouchLatency::state = TouchLatency::IDLE;
+uint32_t TouchLatency::sample_us = 0;
+uint32_t TouchLatency::dispatch_us = 0;
+lv_obj_t *TouchLatency::watch_obj = nullptr;
+lv_area_t TouchLatency::watch_area;
+bool TouchLatency::watch_any = true;
+Histogram TouchLatency::input_time(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS);
+Histogram TouchLatency::render_time(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS);
+Histogram TouchLatency::total_time(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS);
+uint32_t TouchLatency::no_response = 0;
+
+// The flush task completes areas on the other core
+static portMUX_TYPE latency_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static inline uint32_t now_us() {
+    return (uint32_t)esp_timer_get_time();
+}
+
+void TouchLatency::init(lv_display_t *disp, lv_indev_t *indev) {
+    // Input device events are sent after the pressed object's own handlers
+    lv_indev_add_event_cb(indev, indev_event_cb, LV_EVENT_PRESSED, NULL);
+    lv_display_add_event_cb(disp, display_event_cb, LV_EVENT_REFR_START, NULL);
+
+    SerialConsole::registerCommand("latency", "Touch-to-photon latency: latency [reset]", consoleLatency);
+}
+
+void TouchLatency::setWatch(lv_obj_t *obj) {
+    if (watch_obj) lv_obj_remove_event_cb(watch_obj, watch_delete_cb);
+    watch_obj = obj;
+    if (obj) lv_obj_add_event_cb(obj, watch_delete_cb, LV_EVENT_DELETE, NULL);
+}
+
+void TouchLatency::watch_delete_cb(lv_event_t *e) {
+    watch_obj = nullptr;
+}
+
+void TouchLatency::touchSample() {
+    uint32_t now = now_us();
+    checkTimeout(now);
+    if (state != IDLE) return;  // Still following the previous press
+
+    sample_us = now;
+    state = SAMPLED;
+}
+
+void TouchLatency::indev_event_cb(lv_event_t *e) {
+    if (state != SAMPLED) return;
+
+    watch_any = watch_obj == nullptr;
+    if (watch_obj) lv_obj_get_coords(watch_obj, &watch_area);
+
+    dispatch_us = now_us();
+    state = DISPATCHED;
+}
+
+void TouchLatency::display_event_cb(lv_event_t *e) {
+    // Areas already in flight were rendered before the handlers ran, they are not the response
+    if (state == DISPATCHED) state = RENDERING;
+    checkTimeout(now_us());
+}
+
+void TouchLatency::flushDone(const lv_area_t *area) {
+    if (state != RENDERING) return;
+
+    uint32_t now = now_us();
+    portENTER_CRITICAL(&latency_mux);
+    bool matches = state == RENDERING && (watch_any || lv_area_is_on(area, &watch_area));
+    if (matches) {
+        input_time.add(dispatch_us - sample_us);
+        render_time.add(now - dispatch_us);
+        total_time.add(now - sample_us);
+        state = IDLE;
+    }
+    portEXIT_CRITICAL(&latency_mux);
+}
+
+void TouchLatency::checkTimeout(uint32_t now) {
+    portENTER_CRITICAL(&latency_mux);
+    if (state != IDLE && now - sample_us > TOUCH_LATENCY_TIMEOUT_MS * 1000) {
+        no_response++;
+        state = IDLE;
+    }
+    portEXIT_CRITICAL(&latency_mux);
+}
+
+void TouchLatency::dump() {
+    Serial.printf("\n=== Touch Latency, %lu presses (%lu without a visible response) ===\n",
+                  total_time.count(), no_response);
+    if (total_time.count() == 0) return;
+
+    const struct { const char *name; const Histogram &h; } rows[] = {
+        {"input", input_time}, {"render", render_time}, {"total", total_time},
+    };
+    for (const auto &row : rows) {
+        Serial.printf("  %-8s p50 %7.2f  p95 %7.2f  p99 %7.2f  max %7.2f  mean %7.2f ms\n", row.name,
+                      row.h.percentile(50) / 1000.0f, row.h.percentile(95) / 1000.0f,
+                      row.h.percentile(99) / 1000.0f, row.h.max() / 1000.0f, row.h.mean() / 1000.0f);
+    }
+    Serial.println("  input: GT911 read -> PRESSED handled, render: -> response in framebuffer");
+}
+
+uint32_t TouchLatency::totalMedianUs() {
+    portENTER_CRITICAL(&latency_mux);
+    uint32_t median = total_time.count() >= 10 ? total_time.percentile(50) : 0;
+    portEXIT_CRITICAL(&latency_mux);
+    return median;
+}
+
+void TouchLatency::reset() {
+    portENTER_CRITICAL(&latency_mux);
+    input_time.reset();
+    render_time.reset();
+    total_time.reset();
+    no_response = 0;
+    state = IDLE;
+    portEXIT_CRITICAL(&latency_mux);
+}
+
+void TouchLatency::consoleLatency(const char *args) {
+    if (strcmp(args, "reset") == 0) {
+        reset();
+        Serial.println("Touch latency reset");
+    } else {
+        dump();
+    }
+}
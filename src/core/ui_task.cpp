@@ -0,0 +1,71 @@
+#include "core/ui_task.h"
+#include "core/power_manager.h"
+#include "core/touch_driver.h"
+#include "core/dynamic_power.h"
+#include "core/lvgl_lock.h"
+#include "config.h"
+#include <lvgl.h>
+
+// Static member initialization
+TaskHandle_t UiTask::task_handle = nullptr;
+SemaphoreHandle_t UiTask::wake_sem = nullptr;
+
+void UiTask::start() {
+    // A binary semaphore rather than a task notification: LVGL's FreeRTOS port already
+    // uses task notifications of the rendering task to sync with its draw threads
+    wake_sem = xSemaphoreCreateBinary();
+    xTaskCreatePinnedToCore(run, "ui", UI_TASK_STACK_SIZE, NULL, UI_TASK_PRIO, &task_handle, UI_TASK_CORE);
+    Serial.printf("UI task started on core %d\n", UI_TASK_CORE);
+}
+
+void UiTask::notify() {
+    if (wake_sem) xSemaphoreGive(wake_sem);
+}
+
+void IRAM_ATTR UiTask::notifyFromISR() {
+    if (!wake_sem) return;
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(wake_sem, &woken);
+    if (woken) portYIELD_FROM_ISR();
+}
+
+// One pass of the loop, returns how long the task may sleep. The LVGL lock is held from start to
+// finish: code called from here may use LVGL only because of it, as the console, screenshot and
+// mirror tasks change LVGL from the other core under the same lock
+uint32_t UiTask::pass() {
+    LvglLock lock;
+
+    // Update power manager with OFFLINE state (treat as IDLE for power management)
+    PowerManager::update(0);
+
+    // INT line or remote touch: read the input device in this pass
+    TouchDriver::serviceReadRequest();
+
+    // Let the UI do its thing, returns the time until the next LVGL timer is due
+    uint32_t sleep_ms = lv_timer_handler();
+
+    // Redraw and backlight after a wake from SCREEN_OFF, once input has been processed
+    PowerManager::finishWake();
+
+    uint32_t pm_ms = PowerManager::msUntilNextDeadline();
+    if (pm_ms < sleep_ms) sleep_ms = pm_ms;
+    if (sleep_ms > UI_TASK_MAX_SLEEP_MS) sleep_ms = UI_TASK_MAX_SLEEP_MS;
+    if (sleep_ms < 1) sleep_ms = 1;  // Always let the idle task run
+    return sleep_ms;
+}
+
+void UiTask::run(void *param) {
+    while (true) {
+        // Full CPU frequency for the whole pass, dropped again while the task sleeps
+        DynamicPower::renderBegin();
+        uint32_t busy_start = micros();
+
+        uint32_t sleep_ms = pass();
+
+        PowerManager::addBusyTime(micros() - busy_start);
+        DynamicPower::renderEnd();
+
+        // Sleep without the LVGL lock, other tasks get their turn here
+        xSemaphoreTake(wake_sem, pdMS_TO_TICKS(sleep_ms));
+    }
+}
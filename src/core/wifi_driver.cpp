@@ -1,6 +1,62 @@
 #include "core/wifi_driver.h"
+#include "core/serial_console.h"
+#include "config.h"
+#include <Preferences.h>
+
+// Static member initialization
+std::string WiFiDriver::ssid;
+std::string WiFiDriver::passwd;
 
 void WiFiDriver::init()
 {
+    Preferences prefs;
+    prefs.begin(PREFS_NAMESPACE, true);
+    ssid = prefs.getString("wifi_ssid", "").c_str();
+    passwd = prefs.getString("wifi_pass", "").c_str();
+    prefs.end();
+
+    SerialConsole::registerCommand("wifi", "Wi-Fi status, or set credentials: wifi <ssid> <password>", consoleWifi);
+
+    WiFi.mode(WIFI_STA);
+    WiFi.setAutoReconnect(true);
+    connect();
+}
+
+void WiFiDriver::connect()
+{
+    if (ssid.empty()) {
+        Serial.println("WiFiDriver: No credentials stored, use 'wifi <ssid> <password>'");
+        return;
+    }
+
+    // Non-blocking, the station keeps retrying on its own
+    Serial.printf("WiFiDriver: Connecting to '%s'...\n", ssid.c_str());
+    WiFi.begin(ssid.c_str(), passwd.c_str());
+}
+
+void WiFiDriver::consoleWifi(const char *args)
+{
+    if (*args == '\0') {
+        if (isConnected()) {
+            Serial.printf("WiFiDriver: Connected to '%s', IP %s, RSSI %d dBm\n",
+                          ssid.c_str(), WiFi.localIP().toString().c_str(), WiFi.RSSI());
+        } else {
+            Serial.printf("WiFiDriver: Not connected (status %d)\n", WiFi.status());
+        }
+        return;
+    }
+
+    // "<ssid> <password>", the password may be omitted for open networks
+    const char *space = strchr(args, ' ');
+    ssid = space ? std::string(args, space - args) : std::string(args);
+    passwd = space ? std::string(space + 1) : std::string();
+
+    Preferences prefs;
+    prefs.begin(PREFS_NAMESPACE, false);
+    prefs.putString("wifi_ssid", ssid.c_str());
+    prefs.putString("wifi_pass", passwd.c_str());
+    prefs.end();
 
-}
\ No newline at end of file
+    WiFi.disconnect();
+    connect();
+}
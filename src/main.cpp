@@ -3,8 +3,40 @@
 #include <WiFi.h>
 #include "core/core_main.h"
 #include "core/power_manager.h"      // Power Manager module
+#include "core/benchmark.h"          // Optional display benchmarks
+#include "core/ui_task.h"            // LVGL timer handler task
+#include "core/serial_console.h"     // Serial command console
+#include "core/retained_bitmap.h"    // Retained rendering of static subtrees
+#include "core/scenario_bench.h"     // Scripted UI scenarios with budgets
 #include "ui.h"
 
+#ifndef PIO_UNIT_TESTING  // Unit tests bring their own setup()
+// SquareLine screens plus what this board adds to them
+static void ui_setup()
+{
+    ui_init();
+
+    // Wallpaper from the assets partition, if one was flashed
+    const lv_image_dsc_t *wallpaper = AssetStore::get(ASSET_WALLPAPER);
+    if (wallpaper) {
+        lv_image_set_src(ui_Background, wallpaper);
+        Serial.println("Wallpaper loaded from assets partition");
+    }
+#if !UI_BUILTIN_BACKGROUND
+    else {
+        Serial.println("No wallpaper in assets partition, plain background (pio run -t uploadassets)");
+    }
+#endif
+
+#if RETAINED_HOMEBAR
+    // The home bar only changes with its label, blend it over the wallpaper once
+    RetainedBitmap::create(ui_homebar, ui_Background);
+#endif
+
+    // Text area taps respond by showing the keyboard, key taps redraw inside it
+    TouchLatency::setWatch(ui_Primary_Keyboard);
+}
+
 void setup()
 {
     Serial.begin(115200);
@@ -19,25 +51,23 @@ void setup()
     core_init();
 
     // Begin the UI
-    ui_init();
-}
-
-// Main application loop
-void loop()
-{
-    // Grab the current time
-    uint32_t currentMillis = millis();
+    ui_setup();
 
-    // Update LVGL tick (CRITICAL for timers and input device polling!)
-    static uint32_t lastTick = 0;
-    lv_tick_inc(currentMillis - lastTick);
-    lastTick = currentMillis;
+#ifdef HOMEPANEL_BENCHMARK
+    ScenarioBench::setUiInit(ui_setup);
+    Benchmark::runAll();
+#endif
 
-    // Update power manager with OFFLINE state (treat as IDLE for power management)
-    PowerManager::update(0);
+    // Commands registered during init become available from here
+    SerialConsole::start();
 
-    // Let the UI do its thing
-    lv_timer_handler();
+    // Hand LVGL over to the UI task
+    UiTask::start();
+}
 
-    delay(5);
+// The Arduino loop task is not used: LVGL runs on the dedicated UI task
+void loop()
+{
+    vTaskDelete(NULL);
 }
+#endif // PIO_UNIT_TESTING
@@ -0,0 +1,64 @@
+// Host implementations behind the stand-in headers in include/native (HOMEPANEL_NATIVE only)
+
+#include <Arduino.h>
+#include <Preferences.h>
+#include <WiFi.h>
+#include <Wire.h>
+#include <chrono>
+#include <thread>
+
+HardwareSerial Serial;
+TwoWire Wire;
+WiFiClass WiFi;
+
+static const auto start_time = std::chrono::steady_clock::now();
+
+uint32_t millis() {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start_time).count();
+}
+
+uint32_t micros() {
+    return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_time).count();
+}
+
+void delay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+// All namespaces, shared by every Preferences instance like the NVS partition
+static std::map<std::string, std::map<std::string, uint64_t>> nvs;
+
+bool Preferences::begin(const char *name, bool read_only) {
+    ns = &nvs[name];
+    this->read_only = read_only;
+    return true;
+}
+
+bool Preferences::clear() {
+    if (!ns || read_only) return false;
+    ns->clear();
+    return true;
+}
+
+bool Preferences::remove(const char *key) {
+    if (!ns || read_only) return false;
+    return ns->erase(key) > 0;
+}
+
+bool Preferences::isKey(const char *key) {
+    return ns && ns->count(key) > 0;
+}
+
+uint64_t Preferences::get(const char *key, uint64_t def) {
+    if (!ns) return def;
+    auto it = ns->find(key);
+    return it == ns->end() ? def : it->second;
+}
+
+size_t Preferences::put(const char *key, uint64_t value, size_t size) {
+    if (!ns || read_only) return 0;
+    (*ns)[key] = value;
+    return size;
+}
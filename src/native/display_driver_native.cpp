@@ -0,0 +1,129 @@
+// DisplayDriver for the host build: same LVGL display setup as the panel (RGB565_SWAPPED, PARTIAL
+// stripes or DIRECT), but the "panel" is a framebuffer in memory and flushes are plain copies
+
+#include "core/display_driver.h"
+#include <cstdlib>
+
+// Static member initialization
+DisplayDriver::FlushObserver DisplayDriver::flush_observer = nullptr;
+uint32_t DisplayDriver::tick_ms = 0;
+
+DisplayDriver::DisplayDriver() : framebuffer(nullptr), disp(nullptr), disp_draw_buf(nullptr),
+                                 disp_draw_buf2(nullptr), buffer_lines(0), buffer_internal(false) {
+}
+
+bool DisplayDriver::init() {
+    uint32_t fb_size = SCREEN_WIDTH * SCREEN_HEIGHT * sizeof(uint16_t);
+    framebuffer = (uint16_t *)calloc(1, fb_size);
+    if (!framebuffer) {
+        Serial.println("ERROR: Failed to allocate the memory framebuffer!");
+        return false;
+    }
+
+    lv_init();
+    lv_tick_set_cb(lv_tick_cb);
+
+    disp = lv_display_create(SCREEN_WIDTH, SCREEN_HEIGHT);
+    lv_display_set_flush_cb(disp, my_disp_flush);
+    lv_display_set_color_format(disp, LV_COLOR_FORMAT_RGB565_SWAPPED);
+
+#if DISPLAY_RENDER_MODE == DISPLAY_RENDER_DIRECT
+    lv_display_set_buffers(disp, framebuffer, NULL, fb_size, LV_DISPLAY_RENDER_MODE_DIRECT);
+    Serial.printf("Display render mode: DIRECT into memory framebuffer (%u bytes)\n", fb_size);
+#else
+    uint32_t stripe_lines = STRIPE_LINES > 0 ? STRIPE_LINES : autoStripeLines();
+    if (!allocDrawBuffers(stripe_lines, true)) return false;
+    Serial.println("Display render mode: PARTIAL with copy to memory framebuffer");
+#endif
+
+    lv_display_set_driver_data(disp, this);
+    return true;
+}
+
+uint32_t DisplayDriver::lv_tick_cb() {
+    return tick_ms;
+}
+
+bool DisplayDriver::allocDrawBuffers(uint32_t lines, bool internal) {
+#if DISPLAY_RENDER_MODE == DISPLAY_RENDER_PARTIAL
+    if (lines == 0) return false;
+
+    // New buffers first, on failure LVGL keeps rendering into the old ones
+    uint32_t buf_bytes = SCREEN_WIDTH * lines * DRAW_BUF_PX_SIZE;
+    lv_color_t *buf1 = (lv_color_t *)aligned_alloc(LV_DRAW_BUF_ALIGN, lv_align_up(buf_bytes, LV_DRAW_BUF_ALIGN));
+    lv_color_t *buf2 = (lv_color_t *)aligned_alloc(LV_DRAW_BUF_ALIGN, lv_align_up(buf_bytes, LV_DRAW_BUF_ALIGN));
+    if (!buf1 || !buf2) {
+        Serial.println("ERROR: Failed to allocate display buffers!");
+        free(buf1);
+        free(buf2);
+        return false;
+    }
+
+    // Flushes complete synchronously, no copy can be in flight here
+    lv_display_set_buffers(disp, buf1, buf2, buf_bytes, LV_DISPLAY_RENDER_MODE_PARTIAL);
+    free(disp_draw_buf);
+    free(disp_draw_buf2);
+    disp_draw_buf = buf1;
+    disp_draw_buf2 = buf2;
+
+    // Host memory has no SRAM/PSRAM split, "internal" is only remembered for the benchmarks
+    buffer_lines = lines;
+    buffer_internal = internal;
+    Serial.printf("Display buffers allocated: 2 x %u bytes (%u lines)\n", buf_bytes, lines);
+    return true;
+#else
+    return false;
+#endif
+}
+
+uint32_t DisplayDriver::autoStripeLines() {
+    // No heap to size against, use the height the panel typically ends up with
+    return NATIVE_STRIPE_LINES;
+}
+
+void DisplayDriver::my_disp_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    DisplayDriver *driver = (DisplayDriver *)lv_display_get_driver_data(disp);
+
+#if DISPLAY_RENDER_MODE == DISPLAY_RENDER_DIRECT
+    if (flush_observer) {
+        flush_observer(area, (uint16_t *)px_map + area->y1 * SCREEN_WIDTH + area->x1, SCREEN_WIDTH);
+    }
+#else
+    uint32_t w = lv_area_get_width(area);
+    if (flush_observer) {
+        flush_observer(area, (uint16_t *)px_map, w);
+    }
+
+    const uint16_t *src = (const uint16_t *)px_map;
+    for (int32_t y = area->y1; y <= area->y2; y++) {
+        memcpy(driver->framebuffer + y * SCREEN_WIDTH + area->x1, src, w * sizeof(uint16_t));
+        src += w;
+    }
+#endif
+
+    lv_display_flush_ready(disp);
+}
+
+void DisplayDriver::setBacklight(uint8_t brightness_percent) {
+    Serial.printf("Backlight set to: %d%% (native)\n", brightness_percent);
+}
+
+void DisplayDriver::fadeBacklight(uint8_t brightness_percent, uint32_t duration_ms) {
+    Serial.printf("Backlight fade to: %d%% over %lu ms (native)\n", brightness_percent, (unsigned long)duration_ms);
+}
+
+void DisplayDriver::setBacklightOn() {
+    setBacklight(100);
+}
+
+void DisplayDriver::setBacklightOff() {
+    Serial.println("Backlight OFF (native)");
+}
+
+// Flushes are synchronous memcpy into the framebuffer
+void DisplayDriver::waitForFlush() {
+}
+
+void DisplayDriver::powerDown() {
+    setBacklightOff();
+}
@@ -0,0 +1,143 @@
+// Host benchmark runner (pio run -e native && .pio/build/native/program [iterations])
+// Exits with 2 if a UI scenario is over its budget and the budget gate is on (scenario_budgets.h)
+// With --replay <trace> [latency_ms] it replays a touch trace through TouchFilter instead
+//
+// Builds the real UI (lib/ui) against the real LVGL configuration and PowerManager, with the
+// panel, touch controller, NVS and I2C replaced by the stand-ins in src/native. The LVGL tick is
+// virtual and there is a single draw unit, so every run renders the same pixels; the framebuffer
+// checksum printed at the end must not change unless the UI or LVGL configuration did.
+
+#include <Arduino.h>
+#include <lvgl.h>
+#include "core/display_driver.h"
+#include "core/touch_driver.h"
+#include "core/power_manager.h"
+#include "core/histogram.h"
+#include "core/scenario_bench.h"
+#include "config.h"
+#include "ui.h"
+
+#ifndef PIO_UNIT_TESTING  // Unit tests bring their own main()
+static DisplayDriver displayDriver;
+
+// src/native/touch_replay.cpp
+int touchReplay(const char *path, int latency_ms);
+
+// Invalidate the whole active screen and refresh it, returns elapsed microseconds
+static uint32_t timeFullRefresh() {
+    lv_display_t *disp = displayDriver.getDisplay();
+    lv_obj_invalidate(lv_display_get_screen_active(disp));
+    uint32_t start = micros();
+    lv_refr_now(disp);
+    return micros() - start;
+}
+
+// Run LVGL for ms of virtual time, one refresh period per step
+static uint32_t runFor(uint32_t ms) {
+    uint32_t start = micros();
+    for (uint32_t t = 0; t < ms; t += LV_DEF_REFR_PERIOD) {
+        DisplayDriver::advanceTick(LV_DEF_REFR_PERIOD);
+        lv_timer_handler();
+    }
+    return micros() - start;
+}
+
+static void printFrames(const char *name, const Histogram &h) {
+    Serial.printf("  %-24s avg %7.2f ms, p50 %7.2f ms, p95 %7.2f ms, max %7.2f ms\n", name,
+                  h.mean() / 1000.0f, h.percentile(50) / 1000.0f, h.percentile(95) / 1000.0f,
+                  h.max() / 1000.0f);
+}
+
+static void printMemory(const char *name) {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    Serial.printf("  %-24s %7u bytes used, peak %7u, frag %u%%\n", name,
+                  (unsigned)(mon.total_size - mon.free_size), (unsigned)mon.max_used, mon.frag_pct);
+}
+
+static uint32_t frameChecksum() {
+    const uint16_t *fb = displayDriver.getFrameBuffer();
+    uint32_t hash = 2166136261u;  // FNV-1a
+    for (uint32_t i = 0; i < SCREEN_WIDTH * SCREEN_HEIGHT; i++) {
+        hash = (hash ^ fb[i]) * 16777619u;
+    }
+    return hash;
+}
+
+int main(int argc, char **argv) {
+    if (argc > 2 && strcmp(argv[1], "--replay") == 0) {
+        return touchReplay(argv[2], argc > 3 ? atoi(argv[3]) : TOUCH_PREDICT_MS);
+    }
+
+    int iterations = argc > 1 ? atoi(argv[1]) : BENCHMARK_ITERATIONS;
+    if (iterations < 1) iterations = 1;
+
+    if (!displayDriver.init()) return 1;
+    static TouchDriver touchDriver;
+    touchDriver.init(displayDriver.getLCD());
+    PowerManager::init(&displayDriver);
+
+    Serial.println("\n=== Native Benchmarks ===");
+    Serial.printf("%dx%d, %s, %d iterations\n", SCREEN_WIDTH, SCREEN_HEIGHT,
+                  DISPLAY_RENDER_MODE == DISPLAY_RENDER_DIRECT ? "direct" : "partial", iterations);
+
+    Serial.println("Memory (LVGL heap):");
+    printMemory("after lv_init");
+
+    // Screen build: first build includes theme and style setup
+    uint32_t start = micros();
+    ui_init();
+    uint32_t first_build_us = micros() - start;
+    printMemory("after ui_init");
+
+    Histogram rebuild(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS);
+    for (int i = 0; i < iterations; i++) {
+        start = micros();
+        lv_obj_t *old_screen = ui_Screen1;
+        ui_Screen1_screen_init();
+        lv_screen_load(ui_Screen1);
+        lv_obj_delete(old_screen);
+        rebuild.add(micros() - start);
+    }
+    printMemory("after rebuilds");
+
+    Serial.println("Screen build:");
+    Serial.printf("  %-24s %7.2f ms\n", "ui_init (first)", first_build_us / 1000.0f);
+    printFrames("ui_Screen1 rebuild", rebuild);
+
+    Serial.println("Frames:");
+    timeFullRefresh();
+    Histogram full(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS);
+    for (int i = 0; i < iterations; i++) {
+        full.add(timeFullRefresh());
+    }
+    printFrames("ui_Screen1 full", full);
+    uint32_t idle_checksum = frameChecksum();
+
+    // Tap TextArea1 through the input device, the keyboard opens like on the panel
+    lv_area_t ta;
+    lv_obj_get_coords(ui_TextArea1, &ta);
+    TouchDriver::injectTouch((ta.x1 + ta.x2) / 2, (ta.y1 + ta.y2) / 2, true);
+    uint32_t tap_us = runFor(100);
+    TouchDriver::injectTouch((ta.x1 + ta.x2) / 2, (ta.y1 + ta.y2) / 2, false);
+    tap_us += runFor(100);
+
+    Histogram keyboard(Histogram::TIME_US_BOUNDS, Histogram::TIME_US_BUCKETS);
+    for (int i = 0; i < iterations; i++) {
+        keyboard.add(timeFullRefresh());
+    }
+    printFrames("with keyboard full", keyboard);
+    Serial.printf("  %-24s %7.2f ms (200 ms of virtual time)\n", "tap TextArea1", tap_us / 1000.0f);
+    printMemory("with keyboard");
+
+    Serial.printf("Framebuffer checksum: idle %08x, keyboard %08x\n", idle_checksum, frameChecksum());
+
+    // Back to the boot state for the scripted scenarios
+    lv_obj_send_event(ui_Primary_Keyboard, LV_EVENT_READY, NULL);
+    lv_textarea_set_text(ui_TextArea1, "");
+    bool passed = ScenarioBench::runAll();
+
+    Serial.println("=== Benchmarks Complete ===");
+    return passed ? 0 : 2;  // Non-zero exit fails CI when a scenario is over budget
+}
+#endif // PIO_UNIT_TESTING
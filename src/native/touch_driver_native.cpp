@@ -0,0 +1,70 @@
+// TouchDriver for the host build: no GT911, the only touches are the injected ones
+// (benchmark scripts), fed through the same read callback and activity hook as on the panel
+
+#include "core/touch_driver.h"
+#include "core/power_manager.h"
+
+static struct {
+    uint16_t x;
+    uint16_t y;
+    bool pressed;
+    bool latched;  // A press that was released again before the next read still counts once
+    bool was_pressed;
+} injectedPoint = {0, 0, false, false, false};
+
+static lv_event_code_t gesture_event = LV_EVENT_ALL;
+
+TouchDriver::TouchDriver() : indev(nullptr) {
+}
+
+bool TouchDriver::init(LGFX *lcd) {
+    indev = lv_indev_create();
+    lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(indev, my_touchpad_read);
+    gesture_event = (lv_event_code_t)lv_event_register_id();
+
+    Serial.println("Touch driver registered with LVGL (injected touches only)");
+    return true;
+}
+
+void TouchDriver::my_touchpad_read(lv_indev_t *indev, lv_indev_data_t *data) {
+    bool pressed = injectedPoint.pressed || injectedPoint.latched;
+    injectedPoint.latched = false;
+
+    if (pressed && !injectedPoint.was_pressed) {
+        PowerManager::onUserActivity();
+    }
+    injectedPoint.was_pressed = pressed;
+
+    data->state = pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    data->point.x = injectedPoint.x;
+    data->point.y = injectedPoint.y;
+}
+
+void TouchDriver::injectTouch(int16_t x, int16_t y, bool pressed) {
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x >= SCREEN_WIDTH) x = SCREEN_WIDTH - 1;
+    if (y >= SCREEN_HEIGHT) y = SCREEN_HEIGHT - 1;
+
+    injectedPoint.x = x;
+    injectedPoint.y = y;
+    injectedPoint.pressed = pressed;
+    if (pressed) injectedPoint.latched = true;
+}
+
+// Single injected point only, no gestures are recognized on the host
+lv_event_code_t TouchDriver::getGestureEvent() {
+    return gesture_event;
+}
+
+// No INT line, no I2C: reads are driven by the benchmarks directly
+void TouchDriver::serviceReadRequest() {
+}
+
+void TouchDriver::dumpStats() {
+    Serial.println("Touch: no I2C traffic in the native build");
+}
+
+void TouchDriver::resetStats() {
+}
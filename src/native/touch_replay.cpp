@@ -0,0 +1,197 @@
+// Touch trace replay (.pio/build/native/program --replay trace.log [latency_ms])
+//
+// Runs recorded GT911 samples ('filter trace' on the panel, see tools/touch_replay.sh) through
+// TouchFilter with a range of prediction horizons and reports, per setting:
+//   error  - distance between the reported point and where the finger is latency_ms later,
+//            when the frame drawn from that point reaches the panel
+//   delay  - time shift that best aligns the reported path with the finger's (negative = ahead)
+//   jitter - mean movement of the reported point while the finger is still
+// The finger path is the raw trace smoothed over 5 samples, centred, so it does not lag.
+
+#include <Arduino.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "core/touch_filter.h"
+#include "config.h"
+
+namespace {
+
+struct Sample {
+    uint32_t t;
+    float x;
+    float y;
+};
+
+typedef std::vector<Sample> Stroke;
+
+struct Result {
+    float error_mean;
+    float error_p95;
+    float delay_ms;
+    float jitter;
+};
+
+// Finger position at time t, interpolated along the smoothed stroke
+Sample fingerAt(const Stroke &finger, float t) {
+    if (t <= finger.front().t) return finger.front();
+    if (t >= finger.back().t) return finger.back();
+    size_t i = 1;
+    while (finger[i].t < t) i++;
+    const Sample &a = finger[i - 1];
+    const Sample &b = finger[i];
+    float f = b.t > a.t ? (t - a.t) / (b.t - a.t) : 0.0f;
+    return { (uint32_t)t, a.x + (b.x - a.x) * f, a.y + (b.y - a.y) * f };
+}
+
+Stroke smooth(const Stroke &raw) {
+    Stroke out = raw;
+    for (size_t i = 0; i < raw.size(); i++) {
+        size_t lo = i >= 2 ? i - 2 : 0;
+        size_t hi = std::min(raw.size() - 1, i + 2);
+        float x = 0, y = 0;
+        for (size_t j = lo; j <= hi; j++) {
+            x += raw[j].x;
+            y += raw[j].y;
+        }
+        out[i].x = x / (hi - lo + 1);
+        out[i].y = y / (hi - lo + 1);
+    }
+    return out;
+}
+
+float distance(const Sample &a, const Sample &b) {
+    return sqrtf((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y));
+}
+
+// filter == nullptr replays the raw samples
+Result replay(const std::vector<Stroke> &strokes, TouchFilter *filter, int latency_ms) {
+    std::vector<float> errors;
+    float jitter_sum = 0;
+    uint32_t jitter_n = 0;
+
+    // Delay search: -40 ms (ahead) .. +60 ms (behind) in 1 ms steps
+    const int shift_min = -40, shift_max = 60;
+    std::vector<double> shift_err(shift_max - shift_min + 1, 0.0);
+    std::vector<uint32_t> shift_n(shift_err.size(), 0);
+
+    for (const Stroke &raw : strokes) {
+        Stroke finger = smooth(raw);
+        if (filter) filter->reset();
+
+        Sample prev_out = {0, 0, 0};
+        for (size_t i = 0; i < raw.size(); i++) {
+            Sample out = raw[i];
+            if (filter) {
+                int16_t fx, fy;
+                filter->update((int16_t)raw[i].x, (int16_t)raw[i].y, raw[i].t, &fx, &fy);
+                out.x = fx;
+                out.y = fy;
+            }
+
+            if (raw[i].t + latency_ms <= raw.back().t) {
+                errors.push_back(distance(out, fingerAt(finger, raw[i].t + latency_ms)));
+            }
+            for (int s = shift_min; s <= shift_max; s++) {
+                float t = (float)raw[i].t - s;
+                if (t < raw.front().t || t > raw.back().t) continue;
+                shift_err[s - shift_min] += distance(out, fingerAt(finger, t));
+                shift_n[s - shift_min]++;
+            }
+            if (i > 0) {
+                float dt = (finger[i].t - finger[i - 1].t) / 1000.0f;
+                if (dt > 0 && distance(finger[i], finger[i - 1]) / dt < 20.0f) {
+                    jitter_sum += distance(out, prev_out);
+                    jitter_n++;
+                }
+            }
+            prev_out = out;
+        }
+    }
+
+    Result r = {0, 0, 0, 0};
+    if (!errors.empty()) {
+        std::sort(errors.begin(), errors.end());
+        double sum = 0;
+        for (float e : errors) sum += e;
+        r.error_mean = sum / errors.size();
+        r.error_p95 = errors[std::min(errors.size() - 1, errors.size() * 95 / 100)];
+    }
+    double best = -1;
+    for (size_t s = 0; s < shift_err.size(); s++) {
+        if (!shift_n[s]) continue;
+        double e = shift_err[s] / shift_n[s];
+        if (best < 0 || e < best) {
+            best = e;
+            r.delay_ms = (int)s + shift_min;
+        }
+    }
+    r.jitter = jitter_n ? jitter_sum / jitter_n : 0;
+    return r;
+}
+
+// Lines of the form "touch,<ms>,<x>,<y>,<down>", anything else (other log output) is skipped
+bool load(const char *path, std::vector<Stroke> &strokes) {
+    FILE *f = fopen(path, "r");
+    if (!f) return false;
+
+    char line[256];
+    Stroke current;
+    while (fgets(line, sizeof(line), f)) {
+        const char *p = strstr(line, "touch,");
+        unsigned long t;
+        int x, y, down;
+        if (!p || sscanf(p, "touch,%lu,%d,%d,%d", &t, &x, &y, &down) != 4) continue;
+        if (down) {
+            current.push_back({ (uint32_t)t, (float)x, (float)y });
+        } else if (!current.empty()) {
+            strokes.push_back(current);
+            current.clear();
+        }
+    }
+    if (!current.empty()) strokes.push_back(current);
+    fclose(f);
+    return true;
+}
+
+void printResult(const char *name, const Result &r) {
+    Serial.printf("  %-22s error mean %6.2f px, p95 %6.2f px   delay %+4.0f ms   jitter %5.2f px\n",
+                  name, r.error_mean, r.error_p95, r.delay_ms, r.jitter);
+}
+
+} // namespace
+
+int touchReplay(const char *path, int latency_ms) {
+    std::vector<Stroke> strokes;
+    if (!load(path, strokes)) {
+        Serial.printf("Replay: cannot open %s\n", path);
+        return 1;
+    }
+    size_t samples = 0;
+    for (const Stroke &s : strokes) samples += s.size();
+    if (samples == 0) {
+        Serial.printf("Replay: no 'touch,' samples in %s\n", path);
+        return 1;
+    }
+
+    Serial.println("\n=== Touch Replay ===");
+    Serial.printf("%s: %u strokes, %u samples, display latency %d ms\n", path,
+                  (unsigned)strokes.size(), (unsigned)samples, latency_ms);
+
+    printResult("raw", replay(strokes, nullptr, latency_ms));
+
+    TouchFilter::Params p = TouchFilter::defaults();
+    const uint16_t horizons[] = { 0, 8, 16, 24, 32 };
+    for (uint16_t predict : horizons) {
+        p.predict_ms = predict;
+        TouchFilter filter(p);
+        char name[32];
+        snprintf(name, sizeof(name), "filter, predict %u ms%s", predict,
+                 predict == TOUCH_PREDICT_MS ? "*" : "");
+        printResult(name, replay(strokes, &filter, latency_ms));
+    }
+    Serial.println("  * = TOUCH_PREDICT_MS");
+    return 0;
+}
@@ -0,0 +1,253 @@
+// Draw kernels (draw_sw_pie.cpp) against the pixels LVGL's C renderer would write
+//
+//   pio test -e native -f test_draw_sw_pie                        C paths
+//   pio test -e elecrow-crowpanel-7-advance -f test_draw_sw_pie   PIE paths, plus concurrent use
+//
+// Random colors, widths (odd ones included), buffer offsets and row strides, so every kernel
+// runs its unaligned head, vector body and tail. Pixels around the target rectangle must not change
+
+#include <unity.h>
+#include <string.h>
+#include <lvgl.h>
+#include <lvgl_private.h>
+#include "core/draw_sw_pie.h"
+
+#define GUARD_PX 16
+#define MAX_W 67
+#define MAX_H 5
+#define MAX_PAD 5
+#define BUF_PX (GUARD_PX * 2 + MAX_H * (MAX_W + MAX_PAD) + 8)
+#define ROUNDS 300
+
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t rnd() {
+    // xorshift32, the same sequence on host and device
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+static uint16_t swap16(uint16_t c) {
+    return (uint16_t)((c >> 8) | (c << 8));
+}
+
+// 16-byte aligned so the offsets below choose the alignment of the first pixel
+alignas(16) static uint16_t dest[BUF_PX];
+alignas(16) static uint16_t expect[BUF_PX];
+alignas(16) static uint16_t src[BUF_PX];
+
+struct Rect {
+    uint32_t offset;   // First pixel, in pixels from the start of the buffer
+    int32_t w;
+    int32_t h;
+    int32_t stride;    // In pixels, >= w
+};
+
+static Rect randomRect() {
+    Rect r;
+    r.offset = GUARD_PX + rnd() % 8;
+    r.w = 1 + rnd() % MAX_W;
+    r.h = 1 + rnd() % MAX_H;
+    r.stride = r.w + rnd() % (MAX_PAD + 1);
+    return r;
+}
+
+static void randomFill(uint16_t *buf) {
+    for (uint32_t i = 0; i < BUF_PX; i++) buf[i] = (uint16_t)rnd();
+}
+
+static lv_color_t randomColor() {
+    uint32_t v = rnd();
+    return lv_color_make(v & 0xFF, (v >> 8) & 0xFF, (v >> 16) & 0xFF);
+}
+
+static void fillDsc(lv_draw_sw_blend_fill_dsc_t *dsc, const Rect &r, lv_color_t color, lv_opa_t opa) {
+    memset(dsc, 0, sizeof(*dsc));
+    dsc->dest_buf = dest + r.offset;
+    dsc->dest_w = r.w;
+    dsc->dest_h = r.h;
+    dsc->dest_stride = r.stride * sizeof(uint16_t);
+    dsc->color = color;
+    dsc->opa = opa;
+}
+
+static void test_fill() {
+    for (int round = 0; round < ROUNDS; round++) {
+        bool swapped = rnd() & 1;
+        Rect r = randomRect();
+        lv_color_t color = randomColor();
+        uint16_t c16 = lv_color_to_u16(color);
+        randomFill(dest);
+        memcpy(expect, dest, sizeof(dest));
+        for (int32_t y = 0; y < r.h; y++) {
+            for (int32_t x = 0; x < r.w; x++) expect[r.offset + y * r.stride + x] = swapped ? swap16(c16) : c16;
+        }
+
+        lv_draw_sw_blend_fill_dsc_t dsc;
+        fillDsc(&dsc, r, color, LV_OPA_COVER);
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, hp_blend_color_to_rgb565(&dsc, swapped));
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(expect, dest, BUF_PX);
+    }
+}
+
+static void imageDsc(lv_draw_sw_blend_image_dsc_t *dsc, const Rect &d, const Rect &s) {
+    memset(dsc, 0, sizeof(*dsc));
+    dsc->dest_buf = dest + d.offset;
+    dsc->dest_w = d.w;
+    dsc->dest_h = d.h;
+    dsc->dest_stride = d.stride * sizeof(uint16_t);
+    dsc->src_buf = src + s.offset;
+    dsc->src_stride = s.stride * sizeof(uint16_t);
+    dsc->src_color_format = LV_COLOR_FORMAT_RGB565;
+    dsc->opa = LV_OPA_COVER;
+    dsc->blend_mode = LV_BLEND_MODE_NORMAL;
+}
+
+static void test_image_copy() {
+    for (int round = 0; round < ROUNDS; round++) {
+        bool swapped = rnd() & 1;
+        Rect d = randomRect();
+        Rect s = randomRect();
+        s.w = d.w;
+        s.h = d.h;
+        if (s.stride < s.w) s.stride = s.w;
+        randomFill(dest);
+        randomFill(src);
+        memcpy(expect, dest, sizeof(dest));
+        for (int32_t y = 0; y < d.h; y++) {
+            for (int32_t x = 0; x < d.w; x++) {
+                expect[d.offset + y * d.stride + x] = src[s.offset + y * s.stride + x];
+            }
+        }
+
+        lv_draw_sw_blend_image_dsc_t dsc;
+        imageDsc(&dsc, d, s);
+        TEST_ASSERT_EQUAL(LV_RESULT_OK, hp_blend_rgb565_to_rgb565(&dsc, swapped, swapped));
+        TEST_ASSERT_EQUAL_HEX16_ARRAY(expect, dest, BUF_PX);
+    }
+}
+
+static void test_image_blend_left_to_lvgl() {
+    // Translucent, masked, non-normal and byte-order changing blends are not handled, the
+    // destination stays untouched
+    Rect r = { GUARD_PX, 17, 3, 20 };
+    static const lv_opa_t mask[MAX_H * (MAX_W + MAX_PAD)] = {};
+    randomFill(dest);
+    randomFill(src);
+    memcpy(expect, dest, sizeof(dest));
+
+    lv_draw_sw_blend_image_dsc_t dsc;
+    imageDsc(&dsc, r, r);
+    dsc.opa = LV_OPA_50;
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, hp_blend_rgb565_to_rgb565(&dsc, true, true));
+    imageDsc(&dsc, r, r);
+    dsc.mask_buf = mask;
+    dsc.mask_stride = r.stride;
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, hp_blend_rgb565_to_rgb565(&dsc, true, true));
+    imageDsc(&dsc, r, r);
+    dsc.blend_mode = LV_BLEND_MODE_ADDITIVE;
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, hp_blend_rgb565_to_rgb565(&dsc, false, false));
+    imageDsc(&dsc, r, r);
+    TEST_ASSERT_EQUAL(LV_RESULT_INVALID, hp_blend_rgb565_to_rgb565(&dsc, false, true));
+    TEST_ASSERT_EQUAL_HEX16_ARRAY(expect, dest, BUF_PX);
+}
+
+#ifndef HOMEPANEL_NATIVE
+#include <Arduino.h>
+#include <esp_heap_caps.h>
+
+// Two draw threads use the q registers at the same time: tasks sharing a core are preempted
+// in the middle of the vector loops, each must still see its own q0 when it resumes
+#define STRESS_TASKS 4
+#define STRESS_PX 4096
+#define STRESS_MS 500
+
+struct StressTask {
+    uint16_t color;
+    uint16_t *buf;
+    uint16_t *pattern;
+    volatile uint32_t rounds;
+    volatile uint32_t errors;
+    volatile bool done;
+};
+
+static void stressTask(void *param) {
+    StressTask *t = (StressTask *)param;
+    uint32_t end = millis() + STRESS_MS;
+    while ((int32_t)(millis() - end) < 0) {
+        hp_fill16(t->buf, STRESS_PX, t->color);
+        for (uint32_t i = 0; i < STRESS_PX; i++) {
+            if (t->buf[i] != t->color) {
+                t->errors++;
+                break;
+            }
+        }
+        hp_copy16(t->buf, t->pattern, STRESS_PX);
+        if (memcmp(t->buf, t->pattern, STRESS_PX * sizeof(uint16_t)) != 0) t->errors++;
+        t->rounds++;
+    }
+    t->done = true;
+    vTaskDelete(NULL);
+}
+
+static void test_concurrent_draw_threads() {
+    StressTask tasks[STRESS_TASKS];
+    for (int i = 0; i < STRESS_TASKS; i++) {
+        StressTask &t = tasks[i];
+        t.color = (uint16_t)(0x1111 * (i + 1));
+        t.buf = (uint16_t *)heap_caps_aligned_alloc(16, STRESS_PX * sizeof(uint16_t), MALLOC_CAP_INTERNAL);
+        t.pattern = (uint16_t *)heap_caps_aligned_alloc(16, STRESS_PX * sizeof(uint16_t), MALLOC_CAP_INTERNAL);
+        TEST_ASSERT_TRUE(t.buf && t.pattern);
+        for (uint32_t p = 0; p < STRESS_PX; p++) t.pattern[p] = (uint16_t)rnd();
+        t.rounds = t.errors = 0;
+        t.done = false;
+    }
+    // Two per core at equal priority, the tick time-slices them mid-kernel
+    for (int i = 0; i < STRESS_TASKS; i++) {
+        xTaskCreatePinnedToCore(stressTask, "pie_stress", 4096, &tasks[i], 1, NULL, i % 2);
+    }
+    for (int i = 0; i < STRESS_TASKS; i++) {
+        while (!tasks[i].done) delay(10);
+    }
+
+    for (int i = 0; i < STRESS_TASKS; i++) {
+        char msg[64];
+        snprintf(msg, sizeof(msg), "task %d: %lu rounds, %lu errors", i, tasks[i].rounds, tasks[i].errors);
+        TEST_MESSAGE(msg);
+        TEST_ASSERT_TRUE(tasks[i].rounds > 0);
+        TEST_ASSERT_EQUAL(0, tasks[i].errors);
+        heap_caps_free(tasks[i].buf);
+        heap_caps_free(tasks[i].pattern);
+    }
+}
+#endif
+
+void setUp() {}
+
+void tearDown() {}
+
+static int runTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_fill);
+    RUN_TEST(test_image_copy);
+    RUN_TEST(test_image_blend_left_to_lvgl);
+#ifndef HOMEPANEL_NATIVE
+    RUN_TEST(test_concurrent_draw_threads);
+#endif
+    return UNITY_END();
+}
+
+#ifdef HOMEPANEL_NATIVE
+int main() {
+    return runTests();
+}
+#else
+void setup() {
+    delay(2000);  // Let the serial monitor attach
+    runTests();
+}
+
+void loop() {}
+#endif
@@ -0,0 +1,186 @@
+// GestureRecognizer on synthetic GT911 sample sequences
+//
+//   pio test -e native -f test_gesture
+
+#include <unity.h>
+#include "core/gesture.h"
+
+static GestureRecognizer recognizer;
+static Gesture out[GestureRecognizer::MAX_OUT];
+
+static uint8_t none(uint32_t t) {
+    return recognizer.update(nullptr, 0, t, out);
+}
+
+static uint8_t one(int16_t x, int16_t y, uint32_t t) {
+    TouchPoint p = { 0, x, y };
+    return recognizer.update(&p, 1, t, out);
+}
+
+static uint8_t two(int16_t ax, int16_t ay, int16_t bx, int16_t by, uint32_t t) {
+    TouchPoint p[2] = { { 0, ax, ay }, { 1, bx, by } };
+    return recognizer.update(p, 2, t, out);
+}
+
+void setUp() {
+    recognizer.reset();
+}
+
+void tearDown() {}
+
+static void test_tap_is_no_gesture() {
+    TEST_ASSERT_EQUAL(0, one(400, 240, 0));
+    TEST_ASSERT_EQUAL(0, one(402, 241, 50));
+    TEST_ASSERT_EQUAL(0, none(100));
+    TEST_ASSERT_FALSE(recognizer.isMultiTouch());
+}
+
+static void test_long_press() {
+    TEST_ASSERT_EQUAL(0, one(400, 240, 0));
+    TEST_ASSERT_EQUAL(0, one(403, 238, GESTURE_LONG_PRESS_MS - 1));
+    TEST_ASSERT_EQUAL(1, one(404, 239, GESTURE_LONG_PRESS_MS));
+    TEST_ASSERT_EQUAL(Gesture::LONG_PRESS, out[0].type);
+    TEST_ASSERT_EQUAL(Gesture::END, out[0].phase);
+    TEST_ASSERT_EQUAL(400, out[0].start_x);
+    TEST_ASSERT_EQUAL(404, out[0].x);
+
+    // Reported once per press
+    TEST_ASSERT_EQUAL(0, one(404, 239, GESTURE_LONG_PRESS_MS + 500));
+    TEST_ASSERT_EQUAL(0, none(GESTURE_LONG_PRESS_MS + 600));
+}
+
+static void test_drag_cancels_long_press() {
+    TEST_ASSERT_EQUAL(0, one(400, 240, 0));
+    TEST_ASSERT_EQUAL(0, one(400 + GESTURE_SLOP_PX + 1, 240, 100));
+    TEST_ASSERT_EQUAL(0, one(400, 240, 200));
+    TEST_ASSERT_EQUAL(0, one(400, 240, GESTURE_LONG_PRESS_MS * 2));
+}
+
+static void test_edge_swipe_from_left() {
+    TEST_ASSERT_EQUAL(0, one(5, 240, 0));
+    TEST_ASSERT_EQUAL(0, one(50, 245, 30));
+    TEST_ASSERT_EQUAL(1, one(5 + GESTURE_SWIPE_MIN_PX, 250, 60));
+    TEST_ASSERT_EQUAL(Gesture::EDGE_SWIPE, out[0].type);
+    TEST_ASSERT_EQUAL(Gesture::RIGHT, out[0].dir);
+    TEST_ASSERT_EQUAL(0, one(300, 250, 90));
+}
+
+static void test_edge_swipe_from_right() {
+    TEST_ASSERT_EQUAL(0, one(SCREEN_WIDTH - 5, 200, 0));
+    TEST_ASSERT_EQUAL(1, one(SCREEN_WIDTH - 5 - GESTURE_SWIPE_MIN_PX, 210, 40));
+    TEST_ASSERT_EQUAL(Gesture::EDGE_SWIPE, out[0].type);
+    TEST_ASSERT_EQUAL(Gesture::LEFT, out[0].dir);
+}
+
+static void test_edge_swipe_needs_inward_travel() {
+    // Starts at the left edge but runs along it
+    TEST_ASSERT_EQUAL(0, one(5, 100, 0));
+    TEST_ASSERT_EQUAL(0, one(30, 300, 60));
+    TEST_ASSERT_EQUAL(0, one(60, 400, 120));
+}
+
+static void test_swipe_in_the_middle_is_no_edge_swipe() {
+    TEST_ASSERT_EQUAL(0, one(400, 240, 0));
+    TEST_ASSERT_EQUAL(0, one(400 + GESTURE_SWIPE_MIN_PX * 2, 240, 60));
+}
+
+static void test_pinch_out() {
+    TEST_ASSERT_EQUAL(0, two(300, 240, 500, 240, 0));
+    TEST_ASSERT_TRUE(recognizer.isMultiTouch());
+
+    // Below the pinch threshold nothing is reported yet
+    TEST_ASSERT_EQUAL(0, two(295, 240, 505, 240, 20));
+
+    TEST_ASSERT_EQUAL(1, two(280, 240, 520, 240, 40));
+    TEST_ASSERT_EQUAL(Gesture::PINCH, out[0].type);
+    TEST_ASSERT_EQUAL(Gesture::BEGIN, out[0].phase);
+    TEST_ASSERT_EQUAL(240 * 256 / 200, out[0].scale_q8);
+    TEST_ASSERT_EQUAL(400, out[0].x);
+
+    TEST_ASSERT_EQUAL(1, two(250, 240, 550, 240, 60));
+    TEST_ASSERT_EQUAL(Gesture::UPDATE, out[0].phase);
+    TEST_ASSERT_EQUAL(300 * 256 / 200, out[0].scale_q8);
+
+    // Same distance, no update
+    TEST_ASSERT_EQUAL(0, two(250, 240, 550, 240, 80));
+
+    TEST_ASSERT_EQUAL(1, none(100));
+    TEST_ASSERT_EQUAL(Gesture::PINCH, out[0].type);
+    TEST_ASSERT_EQUAL(Gesture::END, out[0].phase);
+    TEST_ASSERT_EQUAL(300 * 256 / 200, out[0].scale_q8);
+    TEST_ASSERT_FALSE(recognizer.isMultiTouch());
+}
+
+static void test_pinch_in_ends_when_one_finger_lifts() {
+    TEST_ASSERT_EQUAL(0, two(200, 240, 600, 240, 0));
+    TEST_ASSERT_EQUAL(1, two(300, 240, 500, 240, 40));
+    TEST_ASSERT_EQUAL(Gesture::BEGIN, out[0].phase);
+    TEST_ASSERT_EQUAL(128, out[0].scale_q8);
+
+    TEST_ASSERT_EQUAL(1, one(300, 240, 60));
+    TEST_ASSERT_EQUAL(Gesture::END, out[0].phase);
+
+    // The remaining finger stays frozen and reports nothing until everything lifts
+    TEST_ASSERT_TRUE(recognizer.isMultiTouch());
+    TEST_ASSERT_EQUAL(0, one(300, 240, 60 + GESTURE_LONG_PRESS_MS));
+    TEST_ASSERT_EQUAL(0, none(60 + GESTURE_LONG_PRESS_MS + 20));
+    TEST_ASSERT_FALSE(recognizer.isMultiTouch());
+}
+
+static void test_two_finger_swipe() {
+    TEST_ASSERT_EQUAL(0, two(300, 200, 400, 200, 0));
+    TEST_ASSERT_EQUAL(0, two(340, 205, 440, 205, 30));
+    TEST_ASSERT_EQUAL(1, two(300 + GESTURE_SWIPE_MIN_PX, 210, 400 + GESTURE_SWIPE_MIN_PX, 210, 60));
+    TEST_ASSERT_EQUAL(Gesture::TWO_FINGER_SWIPE, out[0].type);
+    TEST_ASSERT_EQUAL(Gesture::RIGHT, out[0].dir);
+    TEST_ASSERT_EQUAL(350, out[0].start_x);
+
+    // One swipe per touch
+    TEST_ASSERT_EQUAL(0, two(600, 210, 700, 210, 90));
+    TEST_ASSERT_EQUAL(0, none(120));
+}
+
+static void test_two_finger_swipe_up() {
+    TEST_ASSERT_EQUAL(0, two(300, 400, 400, 400, 0));
+    TEST_ASSERT_EQUAL(1, two(310, 400 - GESTURE_SWIPE_MIN_PX, 410, 400 - GESTURE_SWIPE_MIN_PX, 40));
+    TEST_ASSERT_EQUAL(Gesture::UP, out[0].dir);
+}
+
+static void test_second_finger_cancels_long_press() {
+    TEST_ASSERT_EQUAL(0, one(400, 240, 0));
+    TEST_ASSERT_EQUAL(0, two(400, 240, 500, 240, 100));
+    TEST_ASSERT_TRUE(recognizer.isMultiTouch());
+    TEST_ASSERT_EQUAL(0, two(400, 240, 500, 240, GESTURE_LONG_PRESS_MS * 2));
+}
+
+static int runTests() {
+    UNITY_BEGIN();
+    RUN_TEST(test_tap_is_no_gesture);
+    RUN_TEST(test_long_press);
+    RUN_TEST(test_drag_cancels_long_press);
+    RUN_TEST(test_edge_swipe_from_left);
+    RUN_TEST(test_edge_swipe_from_right);
+    RUN_TEST(test_edge_swipe_needs_inward_travel);
+    RUN_TEST(test_swipe_in_the_middle_is_no_edge_swipe);
+    RUN_TEST(test_pinch_out);
+    RUN_TEST(test_pinch_in_ends_when_one_finger_lifts);
+    RUN_TEST(test_two_finger_swipe);
+    RUN_TEST(test_two_finger_swipe_up);
+    RUN_TEST(test_second_finger_cancels_long_press);
+    return UNITY_END();
+}
+
+#ifdef HOMEPANEL_NATIVE
+int main() {
+    return runTests();
+}
+#else
+#include <Arduino.h>
+
+void setup() {
+    delay(2000);  // Let the serial monitor attach
+    runTests();
+}
+
+void loop() {}
+#endif
@@ -0,0 +1,52 @@
+# PlatformIO extra script: build and flash the assets partition
+#
+#   pio run -e elecrow-crowpanel-7-advance -t buildassets
+#   pio run -e elecrow-crowpanel-7-advance -t uploadassets
+#
+# The partition offset and size come from the env's partition table (the "assets" row),
+# so changing wallpapers or icons only needs a data flash, not a firmware build.
+
+import csv
+import os
+
+Import("env")
+
+project_dir = env.subst("$PROJECT_DIR")
+build_dir = env.subst("$BUILD_DIR")
+assets_bin = os.path.join(build_dir, "assets.bin")
+
+
+def find_assets_partition():
+    table = env.BoardConfig().get("build.partitions", "")
+    path = os.path.join(project_dir, table)
+    with open(path) as f:
+        for row in csv.reader(line for line in f if not line.lstrip().startswith("#")):
+            fields = [c.strip() for c in row]
+            if fields and fields[0] == "assets":
+                return int(fields[3], 0), int(fields[4], 0)
+    raise RuntimeError("No 'assets' partition in %s" % path)
+
+
+offset, size = find_assets_partition()
+
+build_cmd = '"$PYTHONEXE" "%s" "%s" "%s" --max-size %d' % (
+    os.path.join(project_dir, "tools", "build_assets.py"),
+    os.path.join(project_dir, "data"), assets_bin, size)
+
+env.AddCustomTarget(
+    name="buildassets",
+    dependencies=None,
+    actions=[build_cmd],
+    title="Build Assets",
+    description="Convert data/ images into the LVGL asset partition image")
+
+env.AddCustomTarget(
+    name="uploadassets",
+    dependencies=None,
+    actions=[
+        build_cmd,
+        '"$PYTHONEXE" "$UPLOADER" --chip esp32s3 --port "$UPLOAD_PORT" --baud $UPLOAD_SPEED '
+        'write_flash 0x%X "%s"' % (offset, assets_bin),
+    ],
+    title="Upload Assets",
+    description="Build and flash the assets partition at 0x%X" % offset)
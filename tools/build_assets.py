@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""Convert the images under data/ into an LVGL-native asset partition image.
+
+Every .png/.jpg/.jpeg/.bmp under data/ becomes one entry, named after its file stem
+(data/wallpaper.png -> "wallpaper"). Opaque images are stored as RGB565, images with
+transparency as RGB565A8 (RGB565 plane followed by an A8 plane). The panel draws them
+straight out of the memory-mapped partition (src/core/asset_store.cpp), so there is no
+decode and no RAM copy at runtime.
+
+Layout (little endian), must match include/core/asset_store.h:
+    header  magic "HPAS", version u16, count u16, total_size u32, reserved u32   (16 bytes)
+    entries count x { name[32], offset u32, size u32, w u16, h u16, format u8,
+                      reserved[3], stride u32, reserved[12] }                   (64 bytes each)
+    data    pixel data of each entry, every entry starts ASSET_ALIGN aligned
+
+    python3 tools/build_assets.py data .pio/assets.bin --max-size 0x100000
+
+Needs Pillow (pip install pillow).
+"""
+
+import argparse
+import struct
+import sys
+from pathlib import Path
+
+MAGIC = b"HPAS"
+VERSION = 1
+HEADER_SIZE = 16
+ENTRY_SIZE = 64
+NAME_LEN = 32
+ASSET_ALIGN = 64  # Cache line, also satisfies LV_DRAW_BUF_ALIGN
+
+FORMAT_RGB565 = 0
+FORMAT_RGB565A8 = 1
+
+IMAGE_SUFFIXES = {".png", ".jpg", ".jpeg", ".bmp"}
+
+
+def align(value, to=ASSET_ALIGN):
+    return (value + to - 1) // to * to
+
+
+def rgb565(r, g, b):
+    return ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+
+
+def convert_pixels(width, height, rgba):
+    """rgba: flat sequence of (r, g, b, a) tuples, row by row. Returns (format, stride, data)."""
+    has_alpha = any(p[3] != 255 for p in rgba)
+    color = bytearray(width * height * 2)
+    for i, (r, g, b, _) in enumerate(rgba):
+        struct.pack_into("<H", color, i * 2, rgb565(r, g, b))
+    if not has_alpha:
+        return FORMAT_RGB565, width * 2, bytes(color)
+    alpha = bytes(p[3] for p in rgba)
+    return FORMAT_RGB565A8, width * 2, bytes(color) + alpha
+
+
+def load_image(path):
+    try:
+        from PIL import Image
+    except ImportError:
+        sys.exit("build_assets: Pillow is required (pip install pillow)")
+    with Image.open(path) as im:
+        im = im.convert("RGBA")
+        return im.width, im.height, list(im.getdata())
+
+
+def build(entries):
+    """entries: list of (name, width, height, format, stride, data). Returns the partition image."""
+    data_start = align(HEADER_SIZE + ENTRY_SIZE * len(entries))
+    table = bytearray()
+    blobs = bytearray()
+    for name, width, height, fmt, stride, data in entries:
+        encoded = name.encode()
+        if len(encoded) >= NAME_LEN:
+            sys.exit(f"build_assets: name too long: {name}")
+        table += struct.pack("<32sIIHHB3xI12x", encoded, data_start + len(blobs), len(data), width, height, fmt, stride)
+        blobs += data + bytes(align(len(data)) - len(data))
+
+    image = bytearray(struct.pack("<4sHHII", MAGIC, VERSION, len(entries), 0, 0))
+    image += table
+    image += bytes(data_start - len(image))
+    image += blobs
+    struct.pack_into("<I", image, 8, len(image))
+    return bytes(image)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("data_dir", type=Path)
+    parser.add_argument("output", type=Path)
+    parser.add_argument("--max-size", type=lambda v: int(v, 0), help="partition size, fail if exceeded")
+    args = parser.parse_args()
+
+    entries = []
+    for path in sorted(args.data_dir.rglob("*")):
+        if path.suffix.lower() not in IMAGE_SUFFIXES:
+            continue
+        width, height, rgba = load_image(path)
+        fmt, stride, data = convert_pixels(width, height, rgba)
+        entries.append((path.stem, width, height, fmt, stride, data))
+        print(f"  {path.stem:<24} {width}x{height} {'RGB565A8' if fmt else 'RGB565':<8} {len(data)} bytes")
+
+    names = [e[0] for e in entries]
+    duplicates = {n for n in names if names.count(n) > 1}
+    if duplicates:
+        sys.exit(f"build_assets: duplicate asset names: {', '.join(sorted(duplicates))}")
+
+    image = build(entries)
+    if args.max_size is not None and len(image) > args.max_size:
+        sys.exit(f"build_assets: {len(image)} bytes do not fit the {args.max_size} byte assets partition")
+
+    args.output.parent.mkdir(parents=True, exist_ok=True)
+    args.output.write_bytes(image)
+    print(f"build_assets: {len(entries)} image(s), {len(image)} bytes -> {args.output}")
+
+
+if __name__ == "__main__":
+    main()
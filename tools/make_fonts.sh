@@ -0,0 +1,33 @@
+#!/bin/sh
+# Generate the LVGL binary fonts loaded at runtime by FontStore (src/core/font_store.cpp)
+#
+#     tools/make_fonts.sh                   # all sizes below into data/fonts/
+#     pio run -e <env> -t uploadfs          # flash them with the rest of data/
+#
+# Needs lv_font_conv (npm install -g lv_font_conv) and Montserrat-Medium.ttf, taken from
+# $MONTSERRAT_TTF or the LVGL sources (.pio/libdeps/<env>/lvgl/scripts/built_in_font/).
+# Same range and bpp as LVGL's built-in Montserrat, so text looks identical.
+
+set -e
+
+SIZES="12 14 16 18 20 22 24 26 32"
+OUT_DIR="$(dirname "$0")/../data/fonts"
+
+TTF="${MONTSERRAT_TTF:-$(find "$(dirname "$0")/../.pio/libdeps" -name Montserrat-Medium.ttf 2>/dev/null | head -n 1)}"
+SYMBOLS="$(dirname "$TTF")/FontAwesome5-Solid+Brands+Regular.woff"
+if [ ! -f "$TTF" ] || [ ! -f "$SYMBOLS" ]; then
+    echo "make_fonts: Montserrat-Medium.ttf / FontAwesome5 not found, set MONTSERRAT_TTF" >&2
+    exit 1
+fi
+
+# LV_SYMBOL_* code points, as in lv_font_montserrat_*.c
+SYMBOL_RANGE=61441,61448,61451,61452,61453,61457,61459,61461,61465,61468,61473,61478,61479,61480,61502,61507,61512,61515,61516,61517,61521,61522,61523,61524,61543,61544,61550,61552,61553,61556,61559,61560,61561,61563,61587,61589,61636,61637,61639,61641,61664,61671,61674,61683,61724,61732,61787,61931,62016,62017,62018,62019,62020,62087,62099,62189,62212,62810,63426,63650
+
+mkdir -p "$OUT_DIR"
+for size in $SIZES; do
+    lv_font_conv --no-compress --no-prefilter --bpp 4 --size "$size" --format bin \
+        --font "$TTF" -r 0x20-0x7F,0xB0,0x2022 \
+        --font "$SYMBOLS" -r "$SYMBOL_RANGE" \
+        -o "$OUT_DIR/montserrat_$size.bin"
+    echo "  montserrat_$size.bin $(wc -c < "$OUT_DIR/montserrat_$size.bin") bytes"
+done
@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+"""Loopback test client for the framebuffer mirror (src/core/mirror_server.cpp).
+
+Connects to ws://<panel>:81/, decodes every delta into a local framebuffer, acknowledges
+frames and reports bytes per frame. With --taps it also injects touches and measures the
+time from sending a touch to the first area coming back (touch -> render -> mirror).
+
+    python3 tools/mirror_client.py 192.168.1.50 --seconds 30 --taps 20 --tap-at 400,240
+    python3 tools/mirror_client.py 192.168.1.50 --dump frame.ppm
+
+The panel firmware must be built with -DMIRROR_ENABLED=1 (off by default, the socket is
+unauthenticated). Only the Python standard library is needed.
+"""
+
+import argparse
+import base64
+import os
+import socket
+import statistics
+import struct
+import time
+
+WIDTH, HEIGHT = 800, 480
+
+
+class WebSocket:
+    """Minimal binary WebSocket client, just enough for the mirror protocol."""
+
+    def __init__(self, host, port):
+        self.sock = socket.create_connection((host, port), timeout=5)
+        key = base64.b64encode(os.urandom(16)).decode()
+        self.sock.sendall((
+            f"GET / HTTP/1.1\r\nHost: {host}:{port}\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n"
+            f"Sec-WebSocket-Key: {key}\r\nSec-WebSocket-Version: 13\r\n\r\n").encode())
+        response = b""
+        while b"\r\n\r\n" not in response:
+            chunk = self.sock.recv(1024)
+            if not chunk:
+                raise ConnectionError("connection closed during handshake")
+            response += chunk
+        header, self.buf = response.split(b"\r\n\r\n", 1)
+        if b" 101 " not in header.split(b"\r\n")[0]:
+            raise ConnectionError(header.decode(errors="replace"))
+        self.message = b""  # Fragments of a message not complete yet
+
+    def _fill(self, n):
+        """Receive until at least n bytes are buffered. A timeout leaves the buffer intact."""
+        while len(self.buf) < n:
+            chunk = self.sock.recv(65536)
+            if not chunk:
+                raise ConnectionError("connection closed")
+            self.buf += chunk
+
+    def recv(self):
+        """Return the next binary message payload (fragments are joined).
+
+        A frame is only consumed once all of it has arrived, so a socket timeout in the
+        middle of a frame loses nothing and the next call picks up where this one stopped.
+        """
+        while True:
+            self._fill(2)
+            b0, b1 = self.buf[0], self.buf[1]
+            n = b1 & 0x7F
+            start = 2
+            if n == 126:
+                self._fill(4)
+                n = struct.unpack_from(">H", self.buf, 2)[0]
+                start = 4
+            elif n == 127:
+                self._fill(10)
+                n = struct.unpack_from(">Q", self.buf, 2)[0]
+                start = 10
+            self._fill(start + n)
+            payload, self.buf = self.buf[start:start + n], self.buf[start + n:]
+
+            opcode = b0 & 0x0F
+            if opcode == 0x9:  # Ping
+                self._send(0xA, payload)
+                continue
+            if opcode == 0x8:
+                raise ConnectionError("closed by server")
+            self.message += payload
+            if b0 & 0x80:
+                message, self.message = self.message, b""
+                return message
+
+    def _send(self, opcode, payload):
+        mask = os.urandom(4)
+        header = bytes([0x80 | opcode])
+        if len(payload) < 126:
+            header += bytes([0x80 | len(payload)])
+        else:
+            header += bytes([0x80 | 126]) + struct.pack(">H", len(payload))
+        masked = bytes(b ^ mask[i % 4] for i, b in enumerate(payload))
+        self.sock.sendall(header + mask + masked)
+
+    def send(self, payload):
+        self._send(0x2, payload)
+
+
+def rle_decode(data, count):
+    """Decode the mirror RLE into a list of RGB565 values."""
+    out = []
+    i = 0
+    while i < len(data):
+        ctl = data[i]
+        i += 1
+        if ctl & 0x80:
+            out.extend([(data[i] << 8) | data[i + 1]] * ((ctl & 0x7F) + 1))
+            i += 2
+        else:
+            for _ in range(ctl + 1):
+                out.append((data[i] << 8) | data[i + 1])
+                i += 2
+    if len(out) != count:
+        raise ValueError(f"area decoded to {len(out)} pixels, expected {count}")
+    return out
+
+
+def percentile(values, p):
+    if not values:
+        return 0.0
+    values = sorted(values)
+    return values[min(len(values) - 1, int(len(values) * p / 100))]
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("host")
+    parser.add_argument("--port", type=int, default=81)
+    parser.add_argument("--seconds", type=float, default=10)
+    parser.add_argument("--taps", type=int, default=0, help="touches to inject for latency")
+    parser.add_argument("--tap-at", default="400,240", help="x,y of injected touches")
+    parser.add_argument("--dump", help="write the mirrored frame to this PPM file at the end")
+    args = parser.parse_args()
+
+    tap_x, tap_y = (int(v) for v in args.tap_at.split(","))
+    fb = [0] * (WIDTH * HEIGHT)
+    ws = WebSocket(args.host, args.port)
+    ws.sock.settimeout(0.5)
+
+    frame_wire = []      # Bytes received per frame (everything between two frame records)
+    frame_reported = []  # Delta bytes per frame as counted by the panel
+    tap_latency = []
+    wire = 0
+    areas = 0
+    tap_sent = None
+    taps_left = args.taps
+    next_tap = time.monotonic() + 1.0
+    start = time.monotonic()
+
+    while time.monotonic() - start < args.seconds:
+        now = time.monotonic()
+        if taps_left and tap_sent is None and now >= next_tap:
+            ws.send(b"T" + struct.pack("<HHB", tap_x, tap_y, 1))
+            ws.send(b"T" + struct.pack("<HHB", tap_x, tap_y, 0))
+            tap_sent = now
+            taps_left -= 1
+
+        try:
+            msg = ws.recv()
+        except socket.timeout:
+            if tap_sent is not None and now - tap_sent > 2.0:
+                print("tap produced no redraw within 2 s, pick a --tap-at over a widget")
+                tap_sent = None
+                next_tap = now + 0.5
+            continue
+
+        wire += len(msg)
+        p = 0
+        while p < len(msg):
+            kind = msg[p]
+            if kind == ord("A"):
+                x, y, w, h, n = struct.unpack_from("<HHHHI", msg, p + 1)
+                pixels = rle_decode(msg[p + 13:p + 13 + n], w * h)
+                for row in range(h):
+                    fb[(y + row) * WIDTH + x:(y + row) * WIDTH + x + w] = pixels[row * w:(row + 1) * w]
+                p += 13 + n
+                areas += 1
+                if tap_sent is not None:
+                    tap_latency.append((time.monotonic() - tap_sent) * 1000)
+                    tap_sent = None
+                    next_tap = time.monotonic() + 0.5
+            elif kind == ord("F"):
+                seq, reported = struct.unpack_from("<II", msg, p + 1)
+                ws.send(b"F" + struct.pack("<I", seq))
+                frame_wire.append(wire)
+                frame_reported.append(reported)
+                wire = 0
+                p += 9
+            else:
+                raise ValueError(f"unknown record 0x{kind:02x}")
+
+    elapsed = time.monotonic() - start
+    print(f"{len(frame_wire)} frames, {areas} areas in {elapsed:.1f} s")
+    if frame_wire:
+        print(f"bytes/frame on the wire: mean {statistics.mean(frame_wire):.0f}, "
+              f"p50 {percentile(frame_wire, 50)}, p95 {percentile(frame_wire, 95)}, max {max(frame_wire)}")
+        print(f"delta bytes/frame (panel): mean {statistics.mean(frame_reported):.0f}, "
+              f"p95 {percentile(frame_reported, 95)} (raw full frame would be {WIDTH * HEIGHT * 2})")
+    if tap_latency:
+        print(f"touch -> first area: p50 {percentile(tap_latency, 50):.1f} ms, "
+              f"p95 {percentile(tap_latency, 95):.1f} ms over {len(tap_latency)} taps")
+
+    if args.dump:
+        with open(args.dump, "wb") as f:
+            f.write(f"P6 {WIDTH} {HEIGHT} 255\n".encode())
+            rgb = bytearray()
+            for v in fb:
+                rgb += bytes((((v >> 11) & 31) * 255 // 31, ((v >> 5) & 63) * 255 // 63, (v & 31) * 255 // 31))
+            f.write(rgb)
+        print(f"frame written to {args.dump}")
+
+
+if __name__ == "__main__":
+    main()
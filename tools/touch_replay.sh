@@ -0,0 +1,19 @@
+#!/bin/sh
+# Replay a recorded touch trace through the pointer filter (src/core/touch_filter.cpp) and
+# report error against the finger versus delay for several prediction horizons
+#
+#     pio device monitor | tee touch.log    # then type 'filter trace', drag and scroll, 'filter trace'
+#     tools/touch_replay.sh touch.log 30     # 30 = touch-to-photon ms, see the 'latency' command
+#
+# Builds and runs the native env, the filter code is the one the panel runs.
+
+set -e
+
+if [ $# -lt 1 ]; then
+    echo "usage: $0 <trace.log> [latency_ms]" >&2
+    exit 1
+fi
+
+ROOT="$(dirname "$0")/.."
+(cd "$ROOT" && pio run -e native -s)
+"$ROOT/.pio/build/native/program" --replay "$1" ${2:+"$2"}